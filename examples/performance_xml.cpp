@@ -1,71 +1,145 @@
 #include <iostream>
+#include <iomanip>
 #include <fstream>
 #include <vector>
 #include <array>
 #include <chrono>
 #include <string.h>
+#include <stdlib.h>
 
 #include "example_config.hpp" // for setting up which string_view implementation is used
 #include "svbb/xml_tokenizer.hpp"
+#include "xml_corpus.hpp"
 
 using namespace std::chrono;
 
-int main(int argc, char** argv)
+// Usage:
+//   performance_xml              benchmark generated documents of every corpus::shape
+//   performance_xml <size MB>    the same with documents of the given size
+//   performance_xml <file>       benchmark a single document
+
+constexpr int num_token_types = static_cast<int>(svbb::xml::ELEMENT::ERROR) + 1;
+using type_array = std::array<double, num_token_types>;
+
+struct pass_result
 {
-    std::ifstream file(argv[1], std::ios::binary | std::ios::ate);
-    auto size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(size);
-    file.read(buffer.data(), size);
-
-    //duration<double> sv_time_span;
-    svbb::string_view input = {buffer.data(), buffer.size()};
-
-    // duration<double> strlen_time_span;
-    // std::cout << "Starting strlen test of " << size << " bytes.";
-    // std::cout << std::endl;
-    // {
-    //     high_resolution_clock::time_point t1 = high_resolution_clock::now();
-    //     // non-sse2 / naive strlen:
-    //     char* ptr = buffer.data();
-    //     while(*(ptr++) != '\0') ;
-    //     size_t size_strlen = ptr - buffer.data();
-
-    //     high_resolution_clock::time_point t2 = high_resolution_clock::now();
-    //     strlen_time_span = duration_cast<duration<double>>(t2 - t1);
-    //     std::cout << "strlen size: " << size_strlen << " bytes; buffer size=" << size << "\n";
-    // }
-
-    std::cout << "Starting XML test of " << size << " bytes.";
-    std::cout << std::endl;
+    type_array count{};
+    size_t tokens = 0;
+    int max_depth = 0;
+};
 
-    constexpr int num_token_types = static_cast<int>(svbb::xml::ELEMENT::ERROR);
-    std::array<size_t, num_token_types + 1> type_counter;
-    type_counter.fill(0);
+pass_result tokenize_pass(svbb::string_view input)
+{
+    pass_result result;
     int depth = 0;
-    int max_depth = 0;
-    high_resolution_clock::time_point t1 = high_resolution_clock::now();
     for(auto xml_token : svbb::xml::tokenize(input)){
-        ++type_counter[static_cast<int>(xml_token.element)];
+        ++result.count[static_cast<int>(xml_token.element)];
+        ++result.tokens;
         if(xml_token.element == svbb::xml::ELEMENT::START_ELEMENT){
             ++depth;
-            max_depth = (depth > max_depth)? depth : max_depth;
+            result.max_depth = (depth > result.max_depth) ? depth : result.max_depth;
         }
         else if(xml_token.element == svbb::xml::ELEMENT::END_ELEMENT)
             --depth;
-        //std::cout << xml_token << "\n";
     }
-    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+    return result;
+}
+
+// Time of a pair of clock reads, subtracted from every timed token.
+double clock_overhead()
+{
+    constexpr int samples = 100000;
+    auto t1 = steady_clock::now();
+    for(int i = 0; i < samples; ++i){
+        auto a = steady_clock::now();
+        auto b = steady_clock::now();
+        if(b < a) std::cout << "";
+    }
+    auto t2 = steady_clock::now();
+    return duration_cast<duration<double>>(t2 - t1).count() / samples;
+}
+
+// Attribute the time of every split() to the type of the token it produced. The clock reads
+// dominate cheap tokens, so this is only good for comparing types with each other.
+type_array per_type_seconds(svbb::string_view input, double overhead)
+{
+    type_array seconds{};
+    svbb::xml::detail::token_state<char, std::char_traits<char>> state(input);
+    while(!state.empty()){
+        auto t1 = steady_clock::now();
+        state.split();
+        auto t2 = steady_clock::now();
+        auto spent = duration_cast<duration<double>>(t2 - t1).count() - overhead;
+        seconds[static_cast<int>(state.current_token().element)] += (spent > 0) ? spent : 0;
+    }
+    return seconds;
+}
+
+void benchmark(const char* name, svbb::string_view input, double overhead)
+{
+    constexpr int repetitions = 5;
 
-    auto sv_time_span = duration_cast<duration<double>>(t2 - t1);
+    // Warm-up, also gives the token counts.
+    const pass_result counts = tokenize_pass(input);
 
-    for(int i = 0; i <= num_token_types; ++i)
-        std::cout << "Element " << static_cast<svbb::xml::ELEMENT>(i) << " has " << type_counter[i] << " occurrences\n";
+    double best = 0;
+    for(int i = 0; i < repetitions; ++i){
+        auto t1 = high_resolution_clock::now();
+        auto result = tokenize_pass(input);
+        auto t2 = high_resolution_clock::now();
+        auto seconds = duration_cast<duration<double>>(t2 - t1).count();
+        if(i == 0 || seconds < best)
+            best = seconds;
+        if(result.tokens != counts.tokens)
+            std::cout << "Token count changed between runs!\n";
+    }
 
-    std::cout << "End depth = " << depth << "; Max depth =" << max_depth << "\n";
-    //std::cout << "strlen took: " << strlen_time_span.count() << " seconds.\n";
-    std::cout << "SVBB XML-SAXish took: " << sv_time_span.count() << " seconds.\n";
+    const type_array seconds = per_type_seconds(input, overhead);
 
+    std::cout << "== " << name << ": " << input.size() << " bytes, " << counts.tokens
+              << " tokens, max depth " << counts.max_depth << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "   " << input.size() / best / 1e6 << " MB/s, " << counts.tokens / best / 1e6
+              << " M tokens/s (best of " << repetitions << ")\n";
+    for(int i = 0; i < num_token_types; ++i){
+        if(counts.count[i] == 0)
+            continue;
+        std::cout << "   " << std::setw(30) << std::left << static_cast<svbb::xml::ELEMENT>(i)
+                  << std::right << std::setw(10) << static_cast<size_t>(counts.count[i])
+                  << " tokens " << std::setw(8) << seconds[i] / counts.count[i] * 1e9
+                  << " ns/token\n";
+    }
     std::cout << std::endl;
 }
+
+int main(int argc, char** argv)
+{
+    const double overhead = clock_overhead();
+
+    size_t size_mb = 16;
+    if(argc > 1){
+        char* end = nullptr;
+        auto value = strtoul(argv[1], &end, 10);
+        if(*end == '\0' && value > 0){
+            size_mb = value;
+        } else {
+            std::ifstream file(argv[1], std::ios::binary | std::ios::ate);
+            if(!file){
+                std::cerr << "Can't open " << argv[1] << "\n";
+                return 1;
+            }
+            auto size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            std::vector<char> buffer(size);
+            file.read(buffer.data(), size);
+            benchmark(argv[1], {buffer.data(), buffer.size()}, overhead);
+            return 0;
+        }
+    }
+
+    for(auto shape : corpus::all_shapes){
+        const std::string document = corpus::generate(shape, size_mb << 20);
+        benchmark(corpus::name(shape), {document.data(), document.size()}, overhead);
+    }
+}
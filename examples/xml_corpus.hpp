@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+
+// Deterministic XML documents of distinct shapes for benchmarking the tokenizer.
+// The same shape, size and seed always give the same document.
+namespace corpus {
+
+enum class shape { DEEP, WIDE, ATTRIBUTES, TEXT, COMMENTS };
+
+constexpr shape all_shapes[] = {shape::DEEP, shape::WIDE, shape::ATTRIBUTES, shape::TEXT,
+                                shape::COMMENTS};
+
+inline const char* name(shape s)
+{
+    switch(s){
+        case shape::DEEP: return "deep nesting";
+        case shape::WIDE: return "wide siblings";
+        case shape::ATTRIBUTES: return "heavy attributes";
+        case shape::TEXT: return "heavy text";
+        case shape::COMMENTS: return "comments and PIs";
+    }
+    return "?";
+}
+
+class generator
+{
+public:
+    explicit generator(std::uint32_t seed) : random_(seed) {}
+
+    // Only the raw engine output is used, distributions differ between standard libraries.
+    size_t below(size_t n) { return random_() % n; }
+
+    void word(std::string& out, size_t min_len, size_t max_len)
+    {
+        static const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        const size_t len = min_len + below(max_len - min_len + 1);
+        for(size_t i = 0; i < len; ++i)
+            out += letters[below(sizeof(letters) - 1)];
+    }
+
+    void text(std::string& out, size_t words)
+    {
+        for(size_t i = 0; i < words; ++i){
+            if(i != 0)
+                out += (below(12) == 0) ? "\n      " : " ";
+            word(out, 1, 10);
+        }
+    }
+
+    void attribute(std::string& out)
+    {
+        out += ' ';
+        word(out, 2, 8);
+        out += "=\"";
+        word(out, 0, 16);
+        out += '"';
+    }
+
+private:
+    std::mt19937 random_;
+};
+
+inline void append_record(std::string& out, shape s, generator& gen)
+{
+    switch(s){
+        case shape::DEEP: {
+            const size_t depth = 16 + gen.below(48);
+            for(size_t i = 0; i < depth; ++i)
+                out += "<level" + std::to_string(i) + ">";
+            gen.word(out, 1, 8);
+            for(size_t i = depth; i-- > 0;)
+                out += "</level" + std::to_string(i) + ">";
+            out += '\n';
+            break;
+        }
+        case shape::WIDE:
+            out += "  <item>";
+            gen.word(out, 1, 12);
+            out += "</item>\n";
+            if(gen.below(4) == 0)
+                out += "  <empty/>\n";
+            break;
+        case shape::ATTRIBUTES: {
+            out += "  <record";
+            const size_t count = 4 + gen.below(12);
+            for(size_t i = 0; i < count; ++i)
+                gen.attribute(out);
+            out += (gen.below(2) == 0) ? "/>\n" : "></record>\n";
+            break;
+        }
+        case shape::TEXT:
+            out += "  <paragraph>";
+            gen.text(out, 40 + gen.below(200));
+            out += "</paragraph>\n";
+            break;
+        case shape::COMMENTS:
+            out += "  <!-- ";
+            gen.text(out, 4 + gen.below(20));
+            out += " <not> a tag -->\n  <?process ";
+            gen.text(out, 2 + gen.below(6));
+            out += "?>\n  <value>";
+            gen.word(out, 1, 8);
+            out += "</value>\n";
+            break;
+    }
+}
+
+// A document of at least 'size' bytes.
+inline std::string generate(shape s, size_t size, std::uint32_t seed = 42)
+{
+    generator gen(seed);
+    std::string out = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<corpus>\n";
+    out.reserve(size + 4096);
+    while(out.size() < size)
+        append_record(out, s, gen);
+    out += "</corpus>\n";
+    return out;
+}
+} // namespace corpus
@@ -0,0 +1,214 @@
+#pragma once
+#include <iterator>
+#include <type_traits>
+
+#include "svbb/config.hpp"
+#include "svbb/tokenize.hpp"
+#include "svbb/trim.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// Adaptors for the ranges returned by tokenize(). Instead of stacking iterators, each one
+// wraps the splitter of the range, so a pipeline like
+//   for(auto field : tokenize(line, ',') | trimmed(" \t"_sv) | non_empty | take(4))
+// still is a single token_iterator whose splitter is the composition, and compiles to one
+// loop. transform(f) comes last, it changes what the iterator yields and not the tokens.
+
+// Splitter wrappers. Like utf8_checked, they call the splitter they wrap as non-const.
+template<typename Splitter, typename With>
+class trimming
+{
+public:
+    SVBB_CONSTEXPR trimming() : splitter_(), with_() {}
+    SVBB_CONSTEXPR trimming(Splitter splitter, With with)
+        : splitter_(std::move(splitter)), with_(with)
+    {
+    }
+
+    template<typename CharT, typename Traits>
+    SVBB_CXX14_CONSTEXPR auto operator()(basic_string_view<CharT, Traits> input)
+        -> split_result<CharT, Traits>
+    {
+        auto splitted = splitter_(input);
+        splitted.left = trim(splitted.left, with_);
+        return splitted;
+    }
+
+private:
+    Splitter splitter_;
+    With with_;
+};
+
+template<typename Splitter>
+class skipping_empty
+{
+public:
+    SVBB_CONSTEXPR skipping_empty() : splitter_() {}
+    SVBB_CONSTEXPR explicit skipping_empty(Splitter splitter) : splitter_(std::move(splitter)) {}
+
+    template<typename CharT, typename Traits>
+    SVBB_CXX14_CONSTEXPR auto operator()(basic_string_view<CharT, Traits> input)
+        -> split_result<CharT, Traits>
+    {
+        auto splitted = splitter_(input);
+        while(splitted.left.empty() && !splitted.right.empty())
+            splitted = splitter_(splitted.right);
+        return splitted;
+    }
+
+private:
+    Splitter splitter_;
+};
+
+template<typename Splitter>
+class taking
+{
+public:
+    SVBB_CONSTEXPR taking() : splitter_(), remaining_(0) {}
+    SVBB_CONSTEXPR taking(Splitter splitter, size_t count)
+        : splitter_(std::move(splitter)), remaining_(count)
+    {
+    }
+
+    template<typename CharT, typename Traits>
+    SVBB_CXX14_CONSTEXPR auto operator()(basic_string_view<CharT, Traits> input)
+        -> split_result<CharT, Traits>
+    {
+        if(remaining_ == 0)
+            return {};
+        --remaining_;
+        return splitter_(input);
+    }
+
+private:
+    Splitter splitter_;
+    size_t remaining_;
+};
+
+// Yields f(token) for the tokens of Range. f is called every time the iterator is
+// dereferenced.
+template<typename Range, typename F>
+class transformed_range
+{
+public:
+    using view_type = typename Range::view_type;
+
+    class iterator
+    {
+    public:
+        using base_iterator = typename Range::iterator;
+        using value_type =
+            typename std::decay<decltype(std::declval<const F&>()(std::declval<view_type>()))>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+        using iterator_category = std::input_iterator_tag;
+
+        SVBB_CONSTEXPR iterator() SVBB_NOEXCEPT : base_(), f_(nullptr) {}
+        SVBB_CONSTEXPR iterator(base_iterator base, const F* f) : base_(base), f_(f) {}
+
+        SVBB_CONSTEXPR reference operator*() const { return (*f_)(*base_); }
+        SVBB_CXX14_CONSTEXPR iterator& operator++()
+        {
+            ++base_;
+            return *this;
+        }
+        SVBB_CXX14_CONSTEXPR iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++base_;
+            return tmp;
+        }
+        SVBB_CONSTEXPR bool operator==(const iterator& rhs) const { return base_ == rhs.base_; }
+        SVBB_CONSTEXPR bool operator!=(const iterator& rhs) const { return base_ != rhs.base_; }
+
+    private:
+        base_iterator base_;
+        const F* f_;
+    };
+    using const_iterator = iterator;
+
+    SVBB_CONSTEXPR transformed_range(Range range, F f) : range_(std::move(range)), f_(std::move(f))
+    {
+    }
+
+    SVBB_CXX14_CONSTEXPR iterator begin() const { return iterator(range_.begin(), &f_); }
+    SVBB_CXX14_CONSTEXPR iterator end() const { return iterator(range_.end(), &f_); }
+
+private:
+    Range range_;
+    F f_;
+};
+
+// The adaptors themselves, which only hold their arguments until they are applied.
+template<typename With>
+struct trim_adaptor
+{
+    With with;
+};
+struct non_empty_adaptor
+{
+};
+struct take_adaptor
+{
+    size_t count;
+};
+template<typename F>
+struct transform_adaptor
+{
+    F f;
+};
+
+// Trims tokens with anything trim() accepts: a character, a view of characters or a char_set.
+template<typename With>
+SVBB_CONSTEXPR trim_adaptor<With> trimmed(With with)
+{
+    return {with};
+}
+// Drops empty tokens. Put it after trimmed() to drop the blank ones too. Each translation
+// unit has its own, the adaptor holds nothing.
+static const non_empty_adaptor non_empty{};
+// Stops after the first 'count' tokens.
+SVBB_CONSTEXPR take_adaptor take(size_t count)
+{
+    return {count};
+}
+template<typename F>
+SVBB_CONSTEXPR transform_adaptor<F> transform(F f)
+{
+    return {std::move(f)};
+}
+
+template<typename CharT, typename Traits, typename Splitter, typename With>
+SVBB_CXX14_CONSTEXPR auto operator|(const token_range<CharT, Traits, Splitter>& range,
+                                    trim_adaptor<With> adaptor)
+    -> token_range<CharT, Traits, trimming<Splitter, With>>
+{
+    return tokenize(range.input(), trimming<Splitter, With>(range.splitter(), adaptor.with));
+}
+
+template<typename CharT, typename Traits, typename Splitter>
+SVBB_CXX14_CONSTEXPR auto operator|(const token_range<CharT, Traits, Splitter>& range,
+                                    non_empty_adaptor)
+    -> token_range<CharT, Traits, skipping_empty<Splitter>>
+{
+    return tokenize(range.input(), skipping_empty<Splitter>(range.splitter()));
+}
+
+template<typename CharT, typename Traits, typename Splitter>
+SVBB_CXX14_CONSTEXPR auto operator|(const token_range<CharT, Traits, Splitter>& range,
+                                    take_adaptor adaptor)
+    -> token_range<CharT, Traits, taking<Splitter>>
+{
+    return tokenize(range.input(), taking<Splitter>(range.splitter(), adaptor.count));
+}
+
+template<typename CharT, typename Traits, typename Splitter, typename F>
+SVBB_CXX14_CONSTEXPR auto operator|(token_range<CharT, Traits, Splitter> range,
+                                    transform_adaptor<F> adaptor)
+    -> transformed_range<token_range<CharT, Traits, Splitter>, F>
+{
+    return {std::move(range), std::move(adaptor.f)};
+}
+
+} // END NAMESPACE
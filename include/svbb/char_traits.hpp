@@ -1,5 +1,9 @@
 #pragma once
+#include <cstdint>
+#include <string>
+
 #include "svbb/config.hpp"
+#include "svbb/simd.hpp"
 
 namespace SVBB_NAMESPACE {
 
@@ -25,4 +29,95 @@ struct constexpr_char_traits : public std::char_traits<CharT>
         return nullptr;
     }
 };
+
+// Traits that compare ASCII letters without regard to case, for views that match header names,
+// keywords and the like as they are, without lowercasing them into a string first:
+//   ci_string_view name("Content-Length");
+//   name == ci_string_view("content-length"); // true
+// Since only the traits differ, tokenize(), split_before() and trim() work on such views as
+// on any other. Characters outside 'A' to 'Z' compare as with std::char_traits. At run time
+// compare() and find() fold whole blocks of char with simd::ascii_lower(); as constant
+// expressions they take the same loop as constexpr_char_traits.
+template<typename CharT>
+struct ci_char_traits : public std::char_traits<CharT>
+{
+    static SVBB_CONSTEXPR CharT fold(CharT c) SVBB_NOEXCEPT
+    {
+        return (c >= CharT('A') && c <= CharT('Z')) ? CharT(c - CharT('A') + CharT('a')) : c;
+    }
+    static SVBB_CONSTEXPR bool eq(CharT a, CharT b) SVBB_NOEXCEPT { return fold(a) == fold(b); }
+    static SVBB_CONSTEXPR bool lt(CharT a, CharT b) SVBB_NOEXCEPT
+    {
+        return std::char_traits<CharT>::lt(fold(a), fold(b));
+    }
+
+    static SVBB_CXX14_CONSTEXPR int compare(const CharT* s1, const CharT* s2, size_t n)
+    {
+        size_t i = 0;
+        if(sizeof(CharT) == 1 && !SVBB_IS_CONSTANT_EVALUATED())
+            i = folded_prefix(reinterpret_cast<const char*>(s1),
+                              reinterpret_cast<const char*>(s2), n);
+        for(; i < n; ++i) {
+            if(lt(s1[i], s2[i])) return -1;
+            if(lt(s2[i], s1[i])) return 1;
+        }
+        return 0;
+    }
+    static SVBB_CXX14_CONSTEXPR const CharT* find(const CharT* s, size_t n, const CharT& a)
+    {
+        size_t i = 0;
+        if(sizeof(CharT) == 1 && !SVBB_IS_CONSTANT_EVALUATED())
+            i = folded_find(reinterpret_cast<const char*>(s), n, static_cast<char>(fold(a)));
+        for(; i < n; ++i) {
+            if(eq(s[i], a)) return s + i;
+        }
+        return nullptr;
+    }
+
+private:
+    // Number of leading blocks of s1 and s2 that are equal once folded. The characters from
+    // there on are left to the caller, they may still be equal.
+    static size_t folded_prefix(const char* s1, const char* s2, size_t n) SVBB_NOEXCEPT
+    {
+        size_t i = 0;
+#ifdef SVBB_HAS_SSE2
+        for(; i + 16 <= n; i += 16) {
+            const __m128i a =
+                simd::ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)));
+            const __m128i b =
+                simd::ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i)));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xffff) return i;
+        }
+#endif
+        for(; i + 8 <= n; i += 8) {
+            if(simd::ascii_lower(simd::load64(s1 + i)) != simd::ascii_lower(simd::load64(s2 + i)))
+                return i;
+        }
+        return i;
+    }
+
+    // Index of the first block of s that holds 'folded' once folded, or of the tail that is
+    // too short for a block.
+    static size_t folded_find(const char* s, size_t n, char folded) SVBB_NOEXCEPT
+    {
+        size_t i = 0;
+#ifdef SVBB_HAS_SSE2
+        const __m128i needle = _mm_set1_epi8(folded);
+        for(; i + 16 <= n; i += 16) {
+            const __m128i block =
+                simd::ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)) != 0) return i;
+        }
+#endif
+        for(; i + 8 <= n; i += 8) {
+            const std::uint64_t found = simd::equal_bytes(simd::ascii_lower(simd::load64(s + i)),
+                                                          static_cast<unsigned char>(folded));
+            if(found) return i + simd::first_byte(found);
+        }
+        return i;
+    }
+};
+
+using ci_string_view = basic_string_view<char, ci_char_traits<char>>;
+
 } // namespace SVBB_NAMESPACE
@@ -0,0 +1,185 @@
+#pragma once
+// Needs C++17, fold expressions go over the columns of the schema.
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "svbb/columns.hpp needs C++17"
+#endif
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/parse.hpp"
+#include "svbb/split.hpp"
+#include "svbb/tokenize.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// Schema entry for a column that is kept as text.
+struct text_field
+{
+};
+
+// A text column as offsets into the loaded input and sizes, in two arrays.
+struct text_column
+{
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+
+    size_t size() const SVBB_NOEXCEPT { return sizes.size(); }
+    void reserve(size_t rows)
+    {
+        offsets.reserve(rows);
+        sizes.reserve(rows);
+    }
+};
+
+namespace detail {
+// How a column of type T is stored, and a cell converted before the row is known to be good.
+template<typename T>
+struct column_traits
+{
+    using storage = std::vector<T>;
+    using cell = T;
+
+    template<typename View>
+    static std::errc convert(View field, View, cell& out)
+    {
+        const auto parsed = parse<T>(field);
+        out = parsed.value;
+        return parsed.error;
+    }
+    static void push(storage& column, const cell& value) { column.push_back(value); }
+};
+
+template<>
+struct column_traits<text_field>
+{
+    using storage = text_column;
+    using cell = std::pair<size_t, size_t>;
+
+    template<typename View>
+    static std::errc convert(View field, View input, cell& out)
+    {
+        out = {static_cast<size_t>(field.data() - input.data()), field.size()};
+        return std::errc();
+    }
+    static void push(storage& column, const cell& value)
+    {
+        column.offsets.push_back(value.first);
+        column.sizes.push_back(value.second);
+    }
+};
+} // namespace detail
+
+// Delimited rows loaded column by column: numeric columns into std::vector<T> of values,
+// text_field columns into a text_column. Every column is reserved once for the number of
+// newlines in the input, then lines are split with tokenize() and split_n().
+//   auto sales = load_columns<text_field, std::int64_t, double>(csv, ',');
+//   const std::vector<double>& prices = sales.column<2>();
+//   double total = std::accumulate(prices.begin(), prices.end(), 0.0);
+// Empty lines are skipped and a trailing '\r' is removed. A line with the wrong number of
+// fields, or a field that doesn't convert, is left out and reported to 'status'.
+template<typename CharT, typename Traits, typename... Columns>
+class column_batch
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using storage = std::tuple<typename detail::column_traits<Columns>::storage...>;
+    static constexpr size_t column_count = sizeof...(Columns);
+    static_assert(column_count > 0, "column_batch needs at least one column");
+
+    column_batch(view_type input, CharT delimeter, CharT newline = CharT('\n'),
+                 parse_status* status = nullptr)
+        : input_(input)
+    {
+        load(delimeter, newline, status, std::index_sequence_for<Columns...>());
+    }
+
+    view_type input() const SVBB_NOEXCEPT { return input_; }
+    size_t rows() const SVBB_NOEXCEPT { return rows_; }
+
+    template<size_t I>
+    auto column() const SVBB_NOEXCEPT -> const typename std::tuple_element<I, storage>::type&
+    {
+        return std::get<I>(columns_);
+    }
+
+    // Field 'row' of text column I.
+    template<size_t I>
+    view_type text(size_t row) const
+    {
+        const text_column& c = std::get<I>(columns_);
+        return input_.substr(c.offsets[row], c.sizes[row]);
+    }
+
+private:
+    using row_type = std::tuple<typename detail::column_traits<Columns>::cell...>;
+
+    view_type input_;
+    size_t rows_ = 0;
+    storage columns_;
+
+    template<size_t... I>
+    void load(CharT delimeter, CharT newline, parse_status* status, std::index_sequence<I...>)
+    {
+        const size_t expected =
+            static_cast<size_t>(std::count(input_.begin(), input_.end(), newline)) + 1;
+        (std::get<I>(columns_).reserve(expected), ...);
+
+        row_type row;
+        for(auto line : tokenize(input_, newline)){
+            if(!line.empty() && Traits::eq(line.back(), CharT('\r')))
+                line.remove_suffix(1);
+            if(line.empty())
+                continue;
+            const auto fields = split_n<column_count>(line, delimeter);
+            const bool whole = fields.complete() &&
+                               fields.fields[column_count - 1].find(delimeter) == view_type::npos;
+            const std::errc error = whole ? convert(fields, row, std::index_sequence<I...>()) :
+                                            std::errc::invalid_argument;
+            if(error != std::errc()){
+                report(status, error, line);
+                continue;
+            }
+            (detail::column_traits<Columns>::push(std::get<I>(columns_), std::get<I>(row)), ...);
+            ++rows_;
+        }
+    }
+
+    // Converts the fields into 'row', stopping at the first one that fails.
+    template<size_t... I>
+    std::errc convert(const split_n_result<CharT, Traits, column_count>& fields, row_type& row,
+                      std::index_sequence<I...>) const
+    {
+        std::errc error{};
+        static_cast<void>((((error = detail::column_traits<Columns>::convert(
+                                 fields.fields[I], input_, std::get<I>(row))) == std::errc()) &&
+                           ...));
+        return error;
+    }
+
+    void report(parse_status* status, std::errc error, view_type line) const
+    {
+        if(!status)
+            return;
+        if(status->ok()){
+            status->error = error;
+            status->offset = static_cast<size_t>(line.data() - input_.data());
+        }
+        ++status->skipped;
+    }
+};
+
+// column_batch with the character types taken from 'input':
+//   auto batch = load_columns<text_field, double>(csv, ',');
+template<typename... Columns, typename CharT, typename Traits>
+auto load_columns(basic_string_view<CharT, Traits> input, CharT delimeter,
+                  CharT newline = CharT('\n'), parse_status* status = nullptr)
+    -> column_batch<CharT, Traits, Columns...>
+{
+    return column_batch<CharT, Traits, Columns...>(input, delimeter, newline, status);
+}
+
+} // END NAMESPACE
@@ -20,6 +20,20 @@
 #define SVBB_NOEXCEPT noexcept
 #endif
 
+// True while a constexpr function is being evaluated as a constant expression, so it can take
+// a loop the compiler can run instead of one with intrinsics. Without a way to tell, it is
+// always true and only the constexpr loop is used. Without constexpr it is always false.
+#if defined(SVBB_NO_CONSTEXPR) || defined(SVBB_NO_CXX14_CONSTEXPR)
+#define SVBB_IS_CONSTANT_EVALUATED() false
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define SVBB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifndef SVBB_IS_CONSTANT_EVALUATED
+#define SVBB_IS_CONSTANT_EVALUATED() true
+#endif
+
 #ifndef SVBB_STRING_VIEW_IMPL
 #include <string_view>
 #define SVBB_STRING_VIEW_IMPL std
@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "svbb/config.hpp"
+#include "svbb/simd.hpp"
+#include "svbb/tokenize.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// split_by_char for input where a delimiter preceded by an escape character is part of the
+// token, as in TSV and CSV exports that write "a\,b" or "a\<tab>b". A delimiter is escaped
+// if it follows an odd number of escapes in a row, "a\\,b" still splits. The input is
+// scanned 64 bytes at a time like the JSON tokenizer does it: the escaped characters of a
+// block come from the mask of escapes with simd::escaped_bits(), without looking at the
+// bytes one by one. Tokens are the raw text, unescape() removes the escapes when needed:
+//   split_by_char_escaped<char> splitter('\t');
+//   std::string buffer;
+//   for(auto field : tokenize(line, splitter))
+//       use(splitter.unescape(field, buffer));
+template<typename CharT>
+class split_by_char_escaped
+{
+public:
+    SVBB_CONSTEXPR split_by_char_escaped() : delimeter_(), escape_(CharT('\\')) {}
+    SVBB_CONSTEXPR explicit split_by_char_escaped(CharT delimeter, CharT escape = CharT('\\'))
+        : delimeter_(delimeter), escape_(escape)
+    {
+    }
+
+    template<typename Traits>
+    SVBB_CXX14_CONSTEXPR auto operator()(basic_string_view<CharT, Traits> input) const
+        -> split_result<CharT, Traits>
+    {
+        // A token starts after a delimiter that was not escaped, so no escape carries over
+        // from the one before.
+        // The blocks compare bytes, traits such as ci_char_traits compare characters their own
+        // way and are scanned one by one.
+        size_t pos = 0;
+        if(sizeof(CharT) == 1 && std::is_same<Traits, std::char_traits<CharT>>::value
+           && !SVBB_IS_CONSTANT_EVALUATED())
+            pos = find_blocks(reinterpret_cast<const char*>(input.data()), input.size());
+        else
+            pos = find_scalar(input);
+        return split_around(input, pos);
+    }
+
+    // 'token' without its escapes, each escape is replaced by the character after it. That is
+    // 'token' itself if it has none, otherwise the result is written to 'buffer' and the view
+    // is into it, valid until 'buffer' changes.
+    template<typename Traits, typename Alloc>
+    auto unescape(basic_string_view<CharT, Traits> token,
+                  std::basic_string<CharT, Traits, Alloc>& buffer) const
+        -> basic_string_view<CharT, Traits>
+    {
+        size_t escape = token.find(escape_);
+        if(escape == token.npos)
+            return token;
+        buffer.assign(token.data(), escape);
+        while(escape != token.npos){
+            // An escape at the very end has nothing to escape and is kept.
+            const size_t next = std::min(escape + 1, token.size() - 1);
+            const size_t end = token.find(escape_, next + 1);
+            buffer.append(token.data() + next, std::min(end, token.size()) - next);
+            escape = end;
+        }
+        return basic_string_view<CharT, Traits>(buffer.data(), buffer.size());
+    }
+
+private:
+    CharT delimeter_;
+    CharT escape_;
+
+    template<typename Traits>
+    SVBB_CXX14_CONSTEXPR size_t find_scalar(basic_string_view<CharT, Traits> input) const
+    {
+        bool escaped = false;
+        for(size_t i = 0; i < input.size(); ++i){
+            if(escaped)
+                escaped = false;
+            else if(Traits::eq(input[i], escape_))
+                escaped = true;
+            else if(Traits::eq(input[i], delimeter_))
+                return i;
+        }
+        return input.size();
+    }
+
+    size_t find_blocks(const char* data, size_t size) const SVBB_NOEXCEPT
+    {
+        std::uint64_t carry = 0;
+        for(size_t base = 0; base < size; base += 64){
+            const char* block_data = data + base;
+            std::uint64_t valid = ~std::uint64_t(0);
+            char padded[64];
+            if(size - base < 64){
+                std::memset(padded, 0, sizeof(padded));
+                std::memcpy(padded, block_data, size - base);
+                block_data = padded;
+                valid = (std::uint64_t(1) << (size - base)) - 1;
+            }
+            const simd::block64 block(block_data);
+            const std::uint64_t escaped =
+                simd::escaped_bits(block.equal(static_cast<char>(escape_)), carry);
+            const std::uint64_t found =
+                block.equal(static_cast<char>(delimeter_)) & ~escaped & valid;
+            if(found)
+                return base + simd::count_trailing_zeros(found);
+        }
+        return size;
+    }
+};
+
+// Tokens of 'view' split at 'delimeter' where it is not escaped.
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto tokenize_escaped(basic_string_view<CharT, Traits> view,
+                                           CharT delimeter, CharT escape = CharT('\\'))
+    -> token_range<CharT, Traits, split_by_char_escaped<CharT>>
+{
+    return tokenize(view, split_by_char_escaped<CharT>(delimeter, escape));
+}
+
+} // END NAMESPACE
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "svbb/config.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// 64 bit FNV-1a. 'seed' selects one of a family of hash functions.
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR std::uint64_t fnv1a(basic_string_view<CharT, Traits> input,
+                                         std::uint64_t seed = 0) SVBB_NOEXCEPT
+{
+    using uchar_type = typename std::make_unsigned<CharT>::type;
+    std::uint64_t hash = 14695981039346656037ull ^ (seed * 1099511628211ull);
+    for(size_t i = 0; i < input.size(); ++i){
+        hash ^= static_cast<uchar_type>(input[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Hash of bytes read 8 at a time, for hash tables. The bytes are read in native order, so
+// the value differs between little and big endian machines. hash_state lets a scan that
+// reads the words anyway compute the same hash as hash_bytes on the way:
+//   hash_state h;
+//   for each full word w: h.add(w);
+//   hash = h.finish(tail_bytes, tail_size, total_size);
+class hash_state
+{
+public:
+    SVBB_CONSTEXPR explicit hash_state(std::uint64_t seed = 0) SVBB_NOEXCEPT : hash_(seed) {}
+
+    SVBB_CXX14_CONSTEXPR void add(std::uint64_t word) SVBB_NOEXCEPT
+    {
+        hash_ = (((hash_ << 5) | (hash_ >> 59)) ^ word) * 0x517cc1b727220a95ull;
+    }
+
+    // The last size % 8 bytes, starting at 'tail', and the size in bytes of everything hashed.
+    std::uint64_t finish(const void* tail, size_t tail_size, size_t size) const SVBB_NOEXCEPT
+    {
+        hash_state last = *this;
+        if(tail_size != 0){
+            std::uint64_t word = 0;
+            std::memcpy(&word, tail, tail_size);
+            last.add(word);
+        }
+        std::uint64_t h = last.hash_ ^ size;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+private:
+    std::uint64_t hash_;
+};
+
+inline std::uint64_t hash_bytes(const void* data, size_t size, std::uint64_t seed = 0) SVBB_NOEXCEPT
+{
+    const char* bytes = static_cast<const char*>(data);
+    hash_state state(seed);
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        state.add(word);
+    }
+    return state.finish(bytes + i, size - i, size);
+}
+
+template<typename CharT, typename Traits>
+std::uint64_t hash_bytes(basic_string_view<CharT, Traits> input,
+                         std::uint64_t seed = 0) SVBB_NOEXCEPT
+{
+    return hash_bytes(input.data(), input.size() * sizeof(CharT), seed);
+}
+} // namespace SVBB_NAMESPACE
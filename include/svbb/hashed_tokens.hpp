@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "svbb/config.hpp"
+#include "svbb/hash.hpp"
+#include "svbb/simd.hpp"
+#include "svbb/tokenize.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// split_by_char that also hashes the token it splits off, in the same pass: the input is read
+// 8 bytes at a time, every word is tested for the delimiter and, if it holds none, added to
+// the hash. hash() is equal to hash_bytes(token, seed).
+template<typename CharT>
+class split_by_char_hashed
+{
+public:
+    SVBB_CONSTEXPR split_by_char_hashed() : delimeter_(), seed_(0), hash_(0) {}
+    SVBB_CONSTEXPR explicit split_by_char_hashed(CharT delimeter, std::uint64_t seed = 0)
+        : delimeter_(delimeter), seed_(seed), hash_(0)
+    {
+    }
+
+    template<typename Traits>
+    auto operator()(basic_string_view<CharT, Traits> input) -> split_result<CharT, Traits>
+    {
+        // The words are compared bytewise, other traits find the delimiter their own way.
+        if(sizeof(CharT) != 1 || !std::is_same<Traits, std::char_traits<CharT>>::value){
+            const size_t pos = std::min(input.find(delimeter_), input.size());
+            hash_ = hash_bytes(input.substr(0, pos), seed_);
+            return split_around(input, pos);
+        }
+
+        const char* data = reinterpret_cast<const char*>(input.data());
+        const size_t size = input.size();
+        hash_state state(seed_);
+        size_t word = 0;
+        size_t pos = size;
+        for(; word + 8 <= size; word += 8){
+            const std::uint64_t bytes = simd::load64(data + word);
+            const std::uint64_t found =
+                simd::equal_bytes(bytes, static_cast<unsigned char>(delimeter_));
+            if(found){
+                pos = word + simd::first_byte(found);
+                break;
+            }
+            state.add(bytes);
+        }
+        if(pos == size){
+            pos = word;
+            while(pos < size && !Traits::eq(input[pos], delimeter_))
+                ++pos;
+        }
+        hash_ = state.finish(data + word, pos - word, pos);
+        return split_around(input, pos);
+    }
+
+    // Hash of the token split off last.
+    SVBB_CONSTEXPR std::uint64_t hash() const SVBB_NOEXCEPT { return hash_; }
+
+private:
+    CharT delimeter_;
+    std::uint64_t seed_;
+    std::uint64_t hash_;
+};
+
+template<typename CharT, typename Traits>
+struct hashed_token
+{
+    basic_string_view<CharT, Traits> token;
+    std::uint64_t hash;
+};
+
+// Tokens split at a character, each with its hash_bytes() hash, for grouping and counting
+// without reading the tokens again:
+//   for(auto t : tokenize_hashed(line, ','))
+//       ++counts[pool.intern(t.token, t.hash)];
+template<typename CharT, typename Traits>
+class hashed_token_range
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using base_range = token_range<CharT, Traits, split_by_char_hashed<CharT>>;
+
+    class iterator
+    {
+    public:
+        using value_type = hashed_token<CharT, Traits>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+        using iterator_category = std::forward_iterator_tag;
+
+        SVBB_CONSTEXPR iterator() = default;
+        SVBB_CONSTEXPR explicit iterator(typename base_range::iterator base) : base_(base) {}
+
+        SVBB_CONSTEXPR reference operator*() const SVBB_NOEXCEPT
+        {
+            return {*base_, base_.splitter().hash()};
+        }
+        SVBB_CXX14_CONSTEXPR iterator& operator++()
+        {
+            ++base_;
+            return *this;
+        }
+        SVBB_CXX14_CONSTEXPR iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++base_;
+            return tmp;
+        }
+        SVBB_CONSTEXPR bool operator==(const iterator& rhs) const SVBB_NOEXCEPT
+        {
+            return base_ == rhs.base_;
+        }
+        SVBB_CONSTEXPR bool operator!=(const iterator& rhs) const SVBB_NOEXCEPT
+        {
+            return base_ != rhs.base_;
+        }
+
+    private:
+        typename base_range::iterator base_;
+    };
+    using const_iterator = iterator;
+
+    SVBB_CONSTEXPR explicit hashed_token_range(base_range range) : range_(range) {}
+
+    iterator begin() const { return iterator(range_.begin()); }
+    SVBB_CONSTEXPR iterator end() const SVBB_NOEXCEPT { return iterator(); }
+
+private:
+    base_range range_;
+};
+
+template<typename CharT, typename Traits>
+auto tokenize_hashed(basic_string_view<CharT, Traits> view, CharT delimeter,
+                     std::uint64_t seed = 0) -> hashed_token_range<CharT, Traits>
+{
+    return hashed_token_range<CharT, Traits>(
+        tokenize(view, split_by_char_hashed<CharT>(delimeter, seed)));
+}
+
+} // END NAMESPACE
@@ -0,0 +1,131 @@
+#pragma once
+#include "svbb/char_traits.hpp"
+#include "svbb/config.hpp"
+#include "svbb/kv.hpp"
+#include "svbb/trim.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace http {
+
+enum class STATUS {
+    COMPLETE,   // The request line and all header fields up to the empty line were parsed.
+    INCOMPLETE, // The input ends before the empty line, parse again once more has arrived.
+    INVALID     // Malformed request line or header field.
+};
+
+namespace detail {
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR bool iequals(basic_string_view<CharT, Traits> a,
+                                  basic_string_view<CharT, Traits> b) SVBB_NOEXCEPT
+{
+    return a.size() == b.size() &&
+           ci_char_traits<CharT>::compare(a.data(), b.data(), a.size()) == 0;
+}
+
+inline const char_set& optional_whitespace()
+{
+    static const char_set ows(" \t\r");
+    return ows;
+}
+} // namespace detail
+
+// Request line and header fields of an HTTP/1.1 request, as views into the parsed input.
+// Header fields are kept in the order they came in, the first 32 without allocating.
+template<typename CharT, typename Traits>
+struct request
+{
+    using view_type = basic_string_view<CharT, Traits>;
+    using headers_type = kv::flat_map<CharT, Traits, 32>;
+    using header_type = typename headers_type::value_type;
+
+    STATUS status = STATUS::INCOMPLETE;
+    view_type method;
+    view_type target;
+    view_type version;
+    headers_type headers;
+    // Characters up to and including the empty line, the body starts there.
+    size_t header_size = 0;
+
+    // First header field named 'name', ignoring ASCII case, nullptr if there is none.
+    const header_type* find_header(view_type name) const
+    {
+        for(const auto& h : headers){
+            if(detail::iequals(h.key, name))
+                return &h;
+        }
+        return nullptr;
+    }
+    bool has_header(view_type name) const { return find_header(name) != nullptr; }
+    view_type header(view_type name, view_type otherwise = view_type()) const
+    {
+        const header_type* h = find_header(name);
+        return h ? h->value : otherwise;
+    }
+};
+
+// Parses the request line and header fields of 'input':
+//   auto req = http::parse_headers(received);
+//   if(req.status == http::STATUS::COMPLETE && req.method == "GET"_sv)
+//       serve(req.target, req.header("host"_sv));
+// Lines end with CRLF, a bare LF is accepted too. Field values are trimmed of optional
+// whitespace and left as they are otherwise: obsolete line folding is rejected and repeated
+// fields are not combined. Each line is scanned once, for ':' and then for its end.
+template<typename CharT, typename Traits>
+request<CharT, Traits> parse_headers(basic_string_view<CharT, Traits> input)
+{
+    using kv::detail::find_either;
+    const auto& ows = detail::optional_whitespace();
+    request<CharT, Traits> result;
+    auto invalid = [&](){
+        result.status = STATUS::INVALID;
+        return result;
+    };
+
+    // method SP request-target SP HTTP-version CRLF
+    size_t end = find_either(input, 0, CharT('\n'), CharT('\n'));
+    if(end == input.size())
+        return result;
+    auto line = input.substr(0, end);
+    if(!line.empty() && Traits::eq(line.back(), CharT('\r')))
+        line.remove_suffix(1);
+    const size_t space1 = line.find(CharT(' '));
+    const size_t space2 = (space1 == line.npos) ? line.npos : line.find(CharT(' '), space1 + 1);
+    if(space1 == 0 || space2 == line.npos || space2 == space1 + 1)
+        return invalid();
+    result.method = line.substr(0, space1);
+    result.target = line.substr(space1 + 1, space2 - space1 - 1);
+    result.version = line.substr(space2 + 1);
+    const CharT http_prefix[] = {CharT('H'), CharT('T'), CharT('T'), CharT('P'), CharT('/')};
+    if(result.version.compare(0, 5, basic_string_view<CharT, Traits>(http_prefix, 5)) != 0)
+        return invalid();
+
+    // *( field-name ":" OWS field-value OWS CRLF ) CRLF
+    size_t start = end + 1;
+    while(start < input.size()){
+        const size_t colon = find_either(input, start, CharT(':'), CharT('\n'));
+        if(colon == input.size())
+            return result;
+        if(Traits::eq(input[colon], CharT('\n'))){
+            // Only the empty line ends the header without a ':'.
+            if(colon != start && !(colon == start + 1 && Traits::eq(input[start], CharT('\r'))))
+                return invalid();
+            result.header_size = colon + 1;
+            result.status = STATUS::COMPLETE;
+            return result;
+        }
+        end = find_either(input, colon + 1, CharT('\n'), CharT('\n'));
+        if(end == input.size())
+            return result;
+        const auto name = input.substr(start, colon - start);
+        if(name.empty() || ows.contains(name.front()) || ows.contains(name.back()))
+            return invalid();
+        result.headers.push_back({name, trim(input.substr(colon + 1, end - colon - 1), ows)});
+        start = end + 1;
+    }
+    return result;
+}
+
+}
+
+} // END NAMESPACE
@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/hash.hpp"
+
+namespace SVBB_NAMESPACE {
+
+// Gives every distinct token an id, numbered from 0 in the order they were first seen, and a
+// view of its own copy of the characters. The copies are made once, into large blocks that
+// never move, so views returned by the pool stay valid as long as the pool does and the
+// interned token's source buffer can be reused right away, as with a streaming tokenizer:
+//   intern_pool<char> names;
+//   for(auto token : tokenize(chunk, ' '))
+//       ids.push_back(names.intern(token));
+//   ...
+//   string_view name = names[ids[0]];
+// The table uses open addressing with linear probing and stores the hash of every token,
+// so most mismatches are rejected without touching the characters.
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class intern_pool
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using id_type = std::uint32_t;
+    static constexpr id_type npos = static_cast<id_type>(-1);
+
+    // Characters per block of copies. Tokens longer than half a block get one of their own.
+    explicit intern_pool(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+    intern_pool(const intern_pool&) = delete;
+    intern_pool& operator=(const intern_pool&) = delete;
+    intern_pool(intern_pool&&) = default;
+    intern_pool& operator=(intern_pool&&) = default;
+
+    // Id of 'token', copying it into the pool if it has not been seen before.
+    id_type intern(view_type token) { return intern(token, hash_bytes(token)); }
+
+    // As above, with 'hash' equal to hash_bytes(token) already, as tokenize_hashed() gives.
+    id_type intern(view_type token, std::uint64_t hash)
+    {
+        // Keep the table at most 3/4 full.
+        if((tokens_.size() + 1) * 4 > slots_.size() * 3)
+            grow();
+        slot& s = slots_[find_slot(token, hash)];
+        if(s.id == npos){
+            tokens_.push_back(copy(token));
+            s = {hash, static_cast<id_type>(tokens_.size() - 1)};
+        }
+        return s.id;
+    }
+
+    // Id of 'token', npos if it has not been interned.
+    id_type find(view_type token) const
+    {
+        if(slots_.empty())
+            return npos;
+        return slots_[find_slot(token, hash_bytes(token))].id;
+    }
+
+    // The pool's copy of the token with 'id'.
+    view_type operator[](id_type id) const { return tokens_[id]; }
+    size_t size() const SVBB_NOEXCEPT { return tokens_.size(); }
+    bool empty() const SVBB_NOEXCEPT { return tokens_.empty(); }
+
+private:
+    struct slot
+    {
+        std::uint64_t hash;
+        id_type id;
+    };
+
+    std::vector<slot> slots_;
+    std::vector<view_type> tokens_;
+    std::vector<std::unique_ptr<CharT[]>> blocks_;
+    CharT* free_ = nullptr;
+    size_t free_size_ = 0;
+    size_t block_size_;
+
+    // The slot of 'token', or the empty slot where it would go. slots_ must not be empty.
+    size_t find_slot(view_type token, std::uint64_t hash) const
+    {
+        const size_t mask = slots_.size() - 1;
+        for(size_t i = static_cast<size_t>(hash) & mask;; i = (i + 1) & mask){
+            const slot& s = slots_[i];
+            if(s.id == npos || (s.hash == hash && tokens_[s.id] == token))
+                return i;
+        }
+    }
+
+    void grow()
+    {
+        std::vector<slot> old(std::max<size_t>(16, slots_.size() * 2), slot{0, npos});
+        old.swap(slots_);
+        const size_t mask = slots_.size() - 1;
+        for(const slot& s : old){
+            if(s.id == npos)
+                continue;
+            size_t i = static_cast<size_t>(s.hash) & mask;
+            while(slots_[i].id != npos)
+                i = (i + 1) & mask;
+            slots_[i] = s;
+        }
+    }
+
+    view_type copy(view_type token)
+    {
+        CharT* data;
+        if(token.size() > block_size_ / 2){
+            // Don't give up the rest of the current block for a long token.
+            blocks_.emplace_back(new CharT[token.size()]);
+            data = blocks_.back().get();
+        } else {
+            if(token.size() > free_size_){
+                blocks_.emplace_back(new CharT[block_size_]);
+                free_ = blocks_.back().get();
+                free_size_ = block_size_;
+            }
+            data = free_;
+            free_ += token.size();
+            free_size_ -= token.size();
+        }
+        Traits::copy(data, token.data(), token.size());
+        return view_type(data, token.size());
+    }
+};
+
+} // END NAMESPACE
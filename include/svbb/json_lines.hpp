@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/tokenize.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace json {
+
+// Parallel drivers for newline delimited JSON (JSON Lines). The input is cut into chunks of
+// whole lines, the chunks are handed to worker threads, and every worker splits its chunks
+// with tokenize(chunk, '\n') and passes each record to the callback as a view. Records are
+// usually tokenized there with json::tokenize. Empty lines are skipped and a trailing '\r' is
+// removed.
+//
+// For files, map them and pass the view, or use the std::istream overloads which read
+// threads * chunk_size bytes at a time.
+// 'threads' = 0 uses every core. The callbacks that run on the workers are shared by them and
+// must be safe to call concurrently. Exceptions from the callbacks stop the processing and
+// are rethrown on the calling thread.
+
+namespace detail {
+
+// Pieces of about 'chunk_size' characters that end right after a newline.
+template<typename CharT, typename Traits>
+std::vector<basic_string_view<CharT, Traits>> line_chunks(basic_string_view<CharT, Traits> input,
+                                                          size_t chunk_size)
+{
+    std::vector<basic_string_view<CharT, Traits>> chunks;
+    chunks.reserve(input.size() / std::max<size_t>(chunk_size, 1) + 1);
+    while(!input.empty()){
+        size_t end = input.size();
+        if(chunk_size < input.size()){
+            const size_t newline = input.find(CharT('\n'), chunk_size);
+            end = (newline == input.npos) ? input.size() : newline + 1;
+        }
+        chunks.push_back(input.substr(0, end));
+        input.remove_prefix(end);
+    }
+    return chunks;
+}
+
+template<typename CharT, typename Traits, typename Fn>
+void for_each_record(basic_string_view<CharT, Traits> chunk, Fn& fn)
+{
+    for(auto line : SVBB_NAMESPACE::tokenize(chunk, CharT('\n'))){
+        if(!line.empty() && line.back() == CharT('\r'))
+            line.remove_suffix(1);
+        if(!line.empty())
+            fn(line);
+    }
+}
+
+inline size_t worker_count(size_t threads, size_t chunks)
+{
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(threads, chunks));
+}
+
+// Start 'count' threads running 'work', wait for them, and rethrow the first exception.
+template<typename Work>
+void run_workers(size_t count, Work work)
+{
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto guarded = [&](){
+        try {
+            work();
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if(!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(count - 1);
+    for(size_t i = 1; i < count; ++i)
+        workers.emplace_back(guarded);
+    guarded();
+    for(auto& t : workers)
+        t.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+// Reads 'batch' characters at a time, cut after their last newline, and passes them to
+// 'process'. The rest of a batch is carried over to the next one.
+template<typename CharT, typename Traits, typename Process>
+void for_each_batch(std::basic_istream<CharT, Traits>& in, size_t batch, Process process)
+{
+    using view_type = basic_string_view<CharT, Traits>;
+    std::vector<CharT> buffer;
+    size_t carried = 0;
+    while(in){
+        buffer.resize(carried + batch);
+        in.read(buffer.data() + carried, static_cast<std::streamsize>(batch));
+        const size_t size = carried + static_cast<size_t>(in.gcount());
+        const view_type data(buffer.data(), size);
+        size_t end = size;
+        if(in){
+            const size_t newline = data.rfind(CharT('\n'));
+            end = (newline == view_type::npos) ? 0 : newline + 1;
+        }
+        if(end != 0)
+            process(data.substr(0, end));
+        std::copy(buffer.begin() + end, buffer.begin() + size, buffer.begin());
+        carried = size - end;
+        // A line longer than a batch gets a larger one.
+        if(end == 0)
+            batch *= 2;
+    }
+}
+} // namespace detail
+
+// Calls process(record) for every record of 'input', concurrently and in no particular order.
+template<typename CharT, typename Traits, typename Process>
+void for_each_line(basic_string_view<CharT, Traits> input, Process process, size_t threads = 0,
+                   size_t chunk_size = 1 << 20)
+{
+    const auto chunks = detail::line_chunks(input, chunk_size);
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    detail::run_workers(detail::worker_count(threads, chunks.size()), [&](){
+        try {
+            for(size_t i = next++; i < chunks.size() && !failed; i = next++)
+                detail::for_each_record(chunks[i], process);
+        } catch(...) {
+            failed = true;
+            throw;
+        }
+    });
+}
+
+// Calls map(record) for every record of 'input' on the workers, and consume(result) with the
+// results on the calling thread, in the order of the records. At most a few chunks per
+// worker are buffered ahead of consume.
+template<typename CharT, typename Traits, typename Map, typename Consume>
+void for_each_line_ordered(basic_string_view<CharT, Traits> input, Map map, Consume consume,
+                           size_t threads = 0, size_t chunk_size = 1 << 20)
+{
+    using view_type = basic_string_view<CharT, Traits>;
+    using result_type = typename std::decay<decltype(map(std::declval<view_type>()))>::type;
+
+    struct slot
+    {
+        std::vector<result_type> results;
+        bool ready = false;
+    };
+
+    const auto chunks = detail::line_chunks(input, chunk_size);
+    const size_t workers = detail::worker_count(threads, chunks.size());
+    const size_t window = 4 * workers;
+    std::vector<slot> slots(chunks.size());
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t next = 0;
+    size_t consumed = 0;
+    bool failed = false;
+
+    auto work = [&](){
+        try {
+            while(true){
+                size_t i;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&](){ return failed || next < consumed + window; });
+                    if(failed || next == chunks.size())
+                        return;
+                    i = next++;
+                }
+                std::vector<result_type> results;
+                auto collect = [&](view_type record){ results.push_back(map(record)); };
+                detail::for_each_record(chunks[i], collect);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slots[i].results = std::move(results);
+                    slots[i].ready = true;
+                }
+                changed.notify_all();
+            }
+        } catch(...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+            }
+            changed.notify_all();
+            throw;
+        }
+    };
+
+    // The workers map, the calling thread consumes.
+    std::vector<std::thread> pool;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    for(size_t t = 0; t < workers; ++t){
+        pool.emplace_back([&](){
+            try {
+                work();
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+        });
+    }
+
+    try {
+        for(size_t i = 0; i < chunks.size(); ++i){
+            std::vector<result_type> results;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&](){ return failed || slots[i].ready; });
+                if(failed)
+                    break;
+                results = std::move(slots[i].results);
+                consumed = i + 1;
+            }
+            changed.notify_all();
+            for(auto& r : results)
+                consume(std::move(r));
+        }
+    } catch(...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            if(!error)
+                error = std::current_exception();
+        }
+        changed.notify_all();
+    }
+
+    for(auto& t : pool)
+        t.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+template<typename CharT, typename Traits, typename Process>
+void for_each_line(std::basic_istream<CharT, Traits>& in, Process process, size_t threads = 0,
+                   size_t chunk_size = 1 << 20)
+{
+    const size_t batch = detail::worker_count(threads, static_cast<size_t>(-1)) * chunk_size;
+    detail::for_each_batch(in, batch, [&](basic_string_view<CharT, Traits> data){
+        for_each_line(data, process, threads, chunk_size);
+    });
+}
+
+template<typename CharT, typename Traits, typename Map, typename Consume>
+void for_each_line_ordered(std::basic_istream<CharT, Traits>& in, Map map, Consume consume,
+                           size_t threads = 0, size_t chunk_size = 1 << 20)
+{
+    const size_t batch = detail::worker_count(threads, static_cast<size_t>(-1)) * chunk_size;
+    detail::for_each_batch(in, batch, [&](basic_string_view<CharT, Traits> data){
+        for_each_line_ordered(data, map, std::ref(consume), threads, chunk_size);
+    });
+}
+
+}
+
+} // END NAMESPACE
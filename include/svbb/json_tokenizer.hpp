@@ -0,0 +1,537 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "svbb/config.hpp"
+#include "svbb/simd.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace json {
+// Using NILL for json special value 'null' becasue null or NULL are often
+// preprocessor definitions of (void) or (void*) which can cause
+// issues. BOOLEAN for the same reason with TRUE and FALSE.
+enum class ELEMENT{
+    START_DOCUMENT, END_DOCUMENT, START_OBJECT, END_OBJECT, START_ARRAY, END_ARRAY,
+    STRING, NUMBER, BOOLEAN, NILL, ERROR,
+};
+
+template<typename OSTREAM>
+OSTREAM& operator<<(OSTREAM& os, ELEMENT e)
+{
+    static const char* names[] = {
+        "START_DOCUMENT", "END_DOCUMENT", "START_OBJECT", "END_OBJECT", "START_ARRAY",
+        "END_ARRAY", "STRING", "NUMBER", "BOOLEAN", "NILL", "ERROR", "BAD"
+    };
+
+    auto e_val = static_cast<unsigned>(e);
+    os << names[std::min(e_val, static_cast<unsigned>(ELEMENT::ERROR) + 1)] << "(" << e_val << ")";
+    return os;
+}
+
+// 'key' is the member name of values in objects, empty elsewhere. 'value' is the text of
+// scalars as it is in the document: strings without their quotes and with escapes left in.
+// 'depth' is the number of open containers after the token.
+template<typename CharT, typename Traits>
+struct token {
+    using view_type = basic_string_view<CharT, Traits>;
+    ELEMENT element;
+    view_type key;
+    view_type value;
+    int depth;
+
+    token() : element(ELEMENT::END_DOCUMENT), depth(0) {}
+    token(ELEMENT e, int d = 0) : element(e), depth(d) {}
+    token(ELEMENT e, view_type k, view_type v, int d = 0) : element(e), key(k), value(v), depth(d) {}
+};
+
+template<typename CharT, typename Traits>
+bool operator==(const token<CharT, Traits>& lhs, const token<CharT, Traits>& rhs)
+{
+    return (lhs.element == rhs.element)
+        && (lhs.key == rhs.key)
+        && (lhs.value == rhs.value)
+        && (lhs.depth == rhs.depth);
+}
+
+template<typename OSTREAM, typename CharT, typename Traits>
+OSTREAM& operator<<(OSTREAM& os, const token<CharT, Traits>& obj){
+    os << obj.element << ", key=" << obj.key << ", value=" << obj.value << ", depth=" << obj.depth;
+    return os;
+}
+
+namespace detail {
+
+// Stage one: positions of the structural characters {}[]:, outside of strings and of the
+// quotes that open and close strings, in order. Found 64 bytes at a time with bit masks:
+// escaped quotes are removed with the odd backslash run mask, and a prefix xor of the quotes
+// gives the inside of the strings.
+class structural_index
+{
+public:
+    SVBB_CONSTEXPR structural_index() SVBB_NOEXCEPT
+        : data_(nullptr), size_(0), base_(0), next_block_(0), bits_(0), escape_carry_(0),
+          in_string_(0)
+    {}
+    structural_index(const char* data, size_t size) SVBB_NOEXCEPT
+        : data_(data), size_(size), base_(0), next_block_(0), bits_(0), escape_carry_(0),
+          in_string_(0)
+    {}
+
+    // Position of the next structural character or quote, size() if there is none.
+    size_t next() SVBB_NOEXCEPT
+    {
+        while(bits_ == 0){
+            if(next_block_ >= size_)
+                return size_;
+            load_block();
+        }
+        const size_t pos = base_ + simd::count_trailing_zeros(bits_);
+        bits_ &= bits_ - 1;
+        return pos;
+    }
+
+    SVBB_CONSTEXPR size_t size() const SVBB_NOEXCEPT { return size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t base_;
+    size_t next_block_;
+    std::uint64_t bits_;
+    std::uint64_t escape_carry_;
+    std::uint64_t in_string_;
+
+    void load_block() SVBB_NOEXCEPT
+    {
+        const char* block_data = data_ + next_block_;
+        char padded[64];
+        if(size_ - next_block_ < 64){
+            std::memset(padded, ' ', sizeof(padded));
+            std::memcpy(padded, block_data, size_ - next_block_);
+            block_data = padded;
+        }
+        const simd::block64 block(block_data);
+
+        const std::uint64_t quotes =
+            block.equal('"') & ~simd::escaped_bits(block.equal('\\'), escape_carry_);
+        // Opening quotes and what follows them, up to but without the closing quotes.
+        const std::uint64_t in_string = simd::prefix_xor(quotes) ^ in_string_;
+        in_string_ = (in_string >> 63) ? ~std::uint64_t(0) : 0;
+        const std::uint64_t structural = block.equal('{') | block.equal('}') | block.equal('[')
+            | block.equal(']') | block.equal(':') | block.equal(',');
+
+        bits_ = (structural & ~in_string) | quotes;
+        base_ = next_block_;
+        next_block_ += 64;
+    }
+};
+
+// Stage two: the grammar, driven by the positions of stage one. Text between structural
+// characters is only looked at for scalars and to check it is whitespace.
+template<typename CharT, typename Traits>
+class token_state
+{
+    static_assert(sizeof(CharT) == 1, "JSON is tokenized from byte strings");
+
+    enum class STATE { PRE, VALUE, VALUE_OR_END, KEY, KEY_OR_END, AFTER_VALUE, END, ERROR };
+
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using token_type = token<CharT, Traits>;
+
+    // Deepest nesting of objects and arrays.
+    static constexpr size_t max_depth = 1024;
+
+    token_state() SVBB_NOEXCEPT : state_(STATE::END) {}
+    token_state(view_type input)
+        : state_(STATE::PRE), document_(input),
+          index_(reinterpret_cast<const char*>(input.data()), input.size()),
+          token_(ELEMENT::START_DOCUMENT)
+    {
+    }
+
+    SVBB_CONSTEXPR token_type last_token() const SVBB_NOEXCEPT { return token_; }
+    SVBB_CONSTEXPR const token_type& current_token() const SVBB_NOEXCEPT { return token_; }
+    // Offset of the first character not consumed yet.
+    SVBB_CONSTEXPR size_t position() const SVBB_NOEXCEPT { return pos_; }
+    SVBB_CONSTEXPR size_t depth() const SVBB_NOEXCEPT { return depth_; }
+    SVBB_CONSTEXPR bool empty() const SVBB_NOEXCEPT
+    {
+        return (state_ == STATE::END) || (state_ == STATE::ERROR);
+    }
+
+    void split()
+    {
+        bool have_token = false;
+        while(!have_token){
+            switch(state_){
+                case STATE::PRE:
+                    token_ = {ELEMENT::START_DOCUMENT};
+                    state_ = STATE::VALUE;
+                    have_token = true;
+                    break;
+                case STATE::VALUE: // [[fallthrough]] to VALUE_OR_END
+                case STATE::VALUE_OR_END:
+                    have_token = splitValue();
+                    break;
+                case STATE::KEY: // [[fallthrough]] to KEY_OR_END
+                case STATE::KEY_OR_END:
+                    have_token = splitKey();
+                    break;
+                case STATE::AFTER_VALUE:
+                    have_token = splitAfterValue();
+                    break;
+                default:
+                    // Do nothing  (END or ERROR, leave the last token alone.)
+                    have_token = true;
+                    break;
+            }
+        }
+    }
+
+    // The message is the value of the ERROR token, position() is where the error is.
+    void setError(const char* message)
+    {
+        token_ = {ELEMENT::ERROR, view_type(), message, static_cast<int>(depth_)};
+        state_ = STATE::ERROR;
+    }
+
+private:
+    STATE state_;
+    view_type document_;
+    structural_index index_;
+    token_type token_;
+    view_type key_;
+    size_t pos_ = 0;
+    // Structural position already taken from index_ but not handled, npos if none.
+    size_t pending_ = view_type::npos;
+    size_t depth_ = 0;
+    // Bit per open container, set for objects.
+    std::array<std::uint64_t, max_depth / 64> objects_{};
+
+    size_t nextStructural()
+    {
+        if(pending_ != view_type::npos){
+            const size_t pos = pending_;
+            pending_ = view_type::npos;
+            return pos;
+        }
+        return index_.next();
+    }
+
+    static SVBB_CONSTEXPR bool isSpace(CharT c) SVBB_NOEXCEPT
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // Text from the current position up to 'pos', without surrounding whitespace. Mostly
+    // there is none, so this doesn't go through trim().
+    view_type between(size_t pos) const SVBB_NOEXCEPT
+    {
+        size_t begin = pos_;
+        while(begin < pos && isSpace(document_[begin]))
+            ++begin;
+        while(pos > begin && isSpace(document_[pos - 1]))
+            --pos;
+        return view_type(document_.data() + begin, pos - begin);
+    }
+
+    view_type slice(size_t begin, size_t end) const SVBB_NOEXCEPT
+    {
+        return view_type(document_.data() + begin, end - begin);
+    }
+
+    SVBB_CONSTEXPR bool inObject() const SVBB_NOEXCEPT
+    {
+        return (objects_[(depth_ - 1) / 64] >> ((depth_ - 1) % 64)) & 1;
+    }
+
+    bool open(bool object, ELEMENT element, size_t pos)
+    {
+        if(depth_ == max_depth){
+            setError("Maximum depth exceeded.");
+            return true;
+        }
+        const std::uint64_t bit = std::uint64_t(1) << (depth_ % 64);
+        if(object)
+            objects_[depth_ / 64] |= bit;
+        else
+            objects_[depth_ / 64] &= ~bit;
+        ++depth_;
+        emit(element, view_type(), pos + 1);
+        state_ = object ? STATE::KEY_OR_END : STATE::VALUE_OR_END;
+        return true;
+    }
+
+    bool close(ELEMENT element, size_t pos)
+    {
+        --depth_;
+        key_ = view_type();
+        emit(element, view_type(), pos + 1);
+        state_ = STATE::AFTER_VALUE;
+        return true;
+    }
+
+    void emit(ELEMENT element, view_type value, size_t next)
+    {
+        token_ = {element, key_, value, static_cast<int>(depth_)};
+        key_ = view_type();
+        pos_ = next;
+    }
+
+    bool splitValue()
+    {
+        const size_t pos = nextStructural();
+        const view_type scalar = between(pos);
+        if(!scalar.empty()){
+            pending_ = pos;
+            return splitScalar(scalar, pos);
+        }
+        if(pos == document_.size()){
+            setError("Unexpected end of document.");
+            return true;
+        }
+
+        switch(document_[pos]){
+            case '"': {
+                const size_t closing = index_.next();
+                if(closing == document_.size()){
+                    pos_ = pos;
+                    setError("Unterminated string.");
+                    return true;
+                }
+                emit(ELEMENT::STRING, slice(pos + 1, closing), closing + 1);
+                state_ = STATE::AFTER_VALUE;
+                return true;
+            }
+            case '{': return open(true, ELEMENT::START_OBJECT, pos);
+            case '[': return open(false, ELEMENT::START_ARRAY, pos);
+            case ']':
+                if(state_ == STATE::VALUE_OR_END)
+                    return close(ELEMENT::END_ARRAY, pos);
+                break;
+            default:
+                break;
+        }
+        pos_ = pos;
+        setError("Expected a value.");
+        return true;
+    }
+
+    // A number as JSON has it: an optional '-', 0 or digits that don't start with 0, then an
+    // optional fraction and an optional exponent, each with at least one digit.
+    static SVBB_CXX14_CONSTEXPR bool is_number(view_type text) SVBB_NOEXCEPT
+    {
+        size_t i = 0;
+        auto digits = [&text, &i]() {
+            const size_t start = i;
+            while(i < text.size() && text[i] >= '0' && text[i] <= '9')
+                ++i;
+            return i != start;
+        };
+        if(i < text.size() && text[i] == '-')
+            ++i;
+        if(i < text.size() && text[i] == '0')
+            ++i;
+        else if(!digits())
+            return false;
+        if(i < text.size() && text[i] == '.'){
+            ++i;
+            if(!digits())
+                return false;
+        }
+        if(i < text.size() && (text[i] == 'e' || text[i] == 'E')){
+            ++i;
+            if(i < text.size() && (text[i] == '+' || text[i] == '-'))
+                ++i;
+            if(!digits())
+                return false;
+        }
+        return i == text.size();
+    }
+
+    bool splitScalar(view_type scalar, size_t end)
+    {
+        ELEMENT element = ELEMENT::NUMBER;
+        bool valid = true;
+        switch(scalar[0]){
+            case 't': element = ELEMENT::BOOLEAN; valid = (scalar == view_type("true", 4)); break;
+            case 'f': element = ELEMENT::BOOLEAN; valid = (scalar == view_type("false", 5)); break;
+            case 'n': element = ELEMENT::NILL; valid = (scalar == view_type("null", 4)); break;
+            default: valid = is_number(scalar); break;
+        }
+        if(!valid){
+            pos_ = static_cast<size_t>(scalar.data() - document_.data());
+            setError("Invalid value.");
+            return true;
+        }
+        emit(element, scalar, end);
+        state_ = STATE::AFTER_VALUE;
+        return true;
+    }
+
+    bool splitKey()
+    {
+        const size_t pos = nextStructural();
+        if(!between(pos).empty() || pos == document_.size()){
+            setError("Expected a key.");
+            return true;
+        }
+        if(document_[pos] == '}' && state_ == STATE::KEY_OR_END)
+            return close(ELEMENT::END_OBJECT, pos);
+        if(document_[pos] != '"'){
+            pos_ = pos;
+            setError("Expected a key.");
+            return true;
+        }
+
+        const size_t closing = index_.next();
+        if(closing == document_.size()){
+            pos_ = pos;
+            setError("Unterminated string.");
+            return true;
+        }
+        pos_ = closing + 1;
+        const size_t colon = nextStructural();
+        if(!between(colon).empty() || colon == document_.size() || document_[colon] != ':'){
+            setError("Expected ':' after a key.");
+            return true;
+        }
+        key_ = slice(pos + 1, closing);
+        pos_ = colon + 1;
+        state_ = STATE::VALUE;
+        return false;
+    }
+
+    bool splitAfterValue()
+    {
+        const size_t pos = nextStructural();
+        if(!between(pos).empty()){
+            setError("Expected ',' or the end of a container.");
+            return true;
+        }
+        if(depth_ == 0){
+            if(pos != document_.size()){
+                pos_ = pos;
+                setError("Text after the end of the document.");
+                return true;
+            }
+            pos_ = pos;
+            token_ = {ELEMENT::END_DOCUMENT};
+            state_ = STATE::END;
+            return true;
+        }
+        if(pos == document_.size()){
+            setError("Unexpected end of document.");
+            return true;
+        }
+
+        switch(document_[pos]){
+            case ',':
+                pos_ = pos + 1;
+                state_ = inObject() ? STATE::KEY : STATE::VALUE;
+                return false;
+            case '}':
+                if(inObject())
+                    return close(ELEMENT::END_OBJECT, pos);
+                break;
+            case ']':
+                if(!inObject())
+                    return close(ELEMENT::END_ARRAY, pos);
+                break;
+            default:
+                break;
+        }
+        pos_ = pos;
+        setError("Expected ',' or the end of a container.");
+        return true;
+    }
+};
+} // namespace detail
+
+template<typename CharT, typename Traits>
+class token_iterator
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using value_type = token<CharT, Traits>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+    using iterator_category = std::forward_iterator_tag;
+    using state_type = detail::token_state<CharT, Traits>;
+
+    token_iterator() SVBB_NOEXCEPT = default;
+    token_iterator(view_type input)
+        : state_(input)
+    {
+        advance();
+    }
+
+    reference operator*() const SVBB_NOEXCEPT { return state_.last_token(); }
+    token_iterator& operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    token_iterator operator++(int)
+    {
+        token_iterator tmp = *this;
+        advance();
+        return tmp;
+    }
+
+    bool operator==(const token_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return (!state_.empty() && !rhs.state_.empty()) ?
+                   (state_.position() == rhs.state_.position() &&
+                    state_.current_token().element == rhs.state_.current_token().element) :
+                   (state_.empty() == rhs.state_.empty());
+    }
+    bool operator!=(const token_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    state_type state_;
+
+    void advance() { state_.split(); }
+};
+
+template<typename CharT, typename Traits>
+class token_range
+{
+public:
+    using iterator = token_iterator<CharT, Traits>;
+    using const_iterator = iterator;
+    using view_type = typename iterator::view_type;
+
+    token_range(view_type view)
+        : begin_(view)
+    {
+    }
+
+    auto begin() const SVBB_NOEXCEPT -> iterator { return begin_; }
+    auto end() const SVBB_NOEXCEPT -> iterator { return iterator(); }
+
+private:
+    iterator begin_;
+};
+
+// Tokens of the JSON document 'view': START_DOCUMENT, the values in document order with
+// START_/END_ tokens around objects and arrays, and END_DOCUMENT. Members of objects carry
+// their name as key. Nothing is copied or unescaped.
+template<typename CharT, typename Traits>
+auto tokenize(basic_string_view<CharT, Traits> view) -> token_range<CharT, Traits>
+{
+    return token_range<CharT, Traits>(view);
+}
+
+}
+
+} // END NAMESPACE
@@ -0,0 +1,195 @@
+#pragma once
+#include <array>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/simd.hpp"
+#include "svbb/trim.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace kv {
+
+template<typename CharT, typename Traits>
+struct pair
+{
+    basic_string_view<CharT, Traits> key;
+    basic_string_view<CharT, Traits> value;
+};
+
+// Key/value views in input order. The first InlineCapacity pairs are stored in the object,
+// only the ones after that go to the heap. Lookups compare keys one after the other, which
+// beats hashing at the sizes this is meant for. Duplicate keys are kept, find() returns the
+// first.
+template<typename CharT, typename Traits, size_t InlineCapacity = 16>
+class flat_map
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using value_type = pair<CharT, Traits>;
+    static constexpr size_t inline_capacity = InlineCapacity;
+
+    class const_iterator
+    {
+    public:
+        using value_type = pair<CharT, Traits>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() SVBB_NOEXCEPT : map_(nullptr), index_(0) {}
+        const_iterator(const flat_map* map, size_t index) SVBB_NOEXCEPT
+            : map_(map), index_(index)
+        {}
+
+        reference operator*() const { return (*map_)[index_]; }
+        pointer operator->() const { return &(*map_)[index_]; }
+        const_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++index_;
+            return tmp;
+        }
+        bool operator==(const const_iterator& rhs) const SVBB_NOEXCEPT
+        {
+            return index_ == rhs.index_;
+        }
+        bool operator!=(const const_iterator& rhs) const SVBB_NOEXCEPT { return !(*this == rhs); }
+
+    private:
+        const flat_map* map_;
+        size_t index_;
+    };
+    using iterator = const_iterator;
+
+    size_t size() const SVBB_NOEXCEPT { return size_; }
+    bool empty() const SVBB_NOEXCEPT { return size_ == 0; }
+
+    const value_type& operator[](size_t i) const
+    {
+        return (i < InlineCapacity) ? inline_[i] : spill_[i - InlineCapacity];
+    }
+
+    const_iterator begin() const SVBB_NOEXCEPT { return const_iterator(this, 0); }
+    const_iterator end() const SVBB_NOEXCEPT { return const_iterator(this, size_); }
+
+    void push_back(const value_type& p)
+    {
+        if(size_ < InlineCapacity)
+            inline_[size_] = p;
+        else
+            spill_.push_back(p);
+        ++size_;
+    }
+
+    // First pair with 'key', nullptr if there is none.
+    const value_type* find(view_type key) const
+    {
+        for(size_t i = 0; i < size_; ++i){
+            const value_type& p = (*this)[i];
+            if(p.key == key)
+                return &p;
+        }
+        return nullptr;
+    }
+    bool contains(view_type key) const { return find(key) != nullptr; }
+    // Value of the first pair with 'key', 'otherwise' if there is none.
+    view_type get(view_type key, view_type otherwise = view_type()) const
+    {
+        const value_type* p = find(key);
+        return p ? p->value : otherwise;
+    }
+
+private:
+    std::array<value_type, InlineCapacity> inline_{};
+    std::vector<value_type> spill_;
+    size_t size_ = 0;
+};
+
+namespace detail {
+// Index of the first 'a' or 'b' in input from 'pos' on, input.size() if there is none.
+template<typename CharT, typename Traits>
+size_t find_either(basic_string_view<CharT, Traits> input, size_t pos, CharT a, CharT b)
+{
+    if(sizeof(CharT) == 1){
+        const char set[] = {static_cast<char>(a), static_cast<char>(b)};
+        return pos + simd::find_first_of(reinterpret_cast<const char*>(input.data()) + pos,
+                                         input.size() - pos, set, (a == b) ? 1 : 2);
+    }
+    for(; pos < input.size(); ++pos){
+        if(Traits::eq(input[pos], a) || Traits::eq(input[pos], b))
+            break;
+    }
+    return pos;
+}
+
+struct no_trim
+{
+    template<typename View>
+    SVBB_CONSTEXPR View operator()(View v) const SVBB_NOEXCEPT { return v; }
+};
+
+template<typename CharT, typename Traits>
+struct trim_with
+{
+    basic_string_view<CharT, Traits> whitespace;
+
+    SVBB_CXX14_CONSTEXPR basic_string_view<CharT, Traits> operator()(
+        basic_string_view<CharT, Traits> v) const
+    {
+        return trim(v, whitespace);
+    }
+};
+
+template<typename CharT, typename Traits, typename Trim>
+flat_map<CharT, Traits> parse(basic_string_view<CharT, Traits> input, CharT pair_sep,
+                              CharT kv_sep, Trim trim_view)
+{
+    flat_map<CharT, Traits> result;
+    size_t start = 0;
+    while(start < input.size()){
+        const size_t separator = find_either(input, start, pair_sep, kv_sep);
+        size_t end = separator;
+        basic_string_view<CharT, Traits> value;
+        if(separator < input.size() && Traits::eq(input[separator], kv_sep)){
+            // Any further kv_sep belong to the value.
+            end = find_either(input, separator + 1, pair_sep, pair_sep);
+            value = trim_view(input.substr(separator + 1, end - separator - 1));
+        }
+        const auto key = trim_view(input.substr(start, separator - start));
+        if(!key.empty() || end != separator)
+            result.push_back({key, value});
+        start = end + 1;
+    }
+    return result;
+}
+} // namespace detail
+
+// Pairs of "k1=v1&k2=v2" style input, in one scan over it: 'pair_sep' ends a pair, the first
+// 'kv_sep' of a pair ends its key. Empty pairs are skipped, pairs without 'kv_sep' have an
+// empty value. Keys and values are views into 'input', they aren't unescaped.
+//   auto query = kv::parse("q=svbb&page=2"_sv, '&', '=');
+//   auto page = query.get("page"_sv);
+template<typename CharT, typename Traits>
+flat_map<CharT, Traits> parse(basic_string_view<CharT, Traits> input, CharT pair_sep, CharT kv_sep)
+{
+    return detail::parse(input, pair_sep, kv_sep, detail::no_trim());
+}
+
+// As above, with 'whitespace' trimmed from keys and values, for "k=v; k2 = v2" style input.
+template<typename CharT, typename Traits>
+flat_map<CharT, Traits> parse(basic_string_view<CharT, Traits> input, CharT pair_sep, CharT kv_sep,
+                              basic_string_view<CharT, Traits> whitespace)
+{
+    return detail::parse(input, pair_sep, kv_sep, detail::trim_with<CharT, Traits>{whitespace});
+}
+
+}
+
+} // END NAMESPACE
@@ -14,4 +14,9 @@ SVBB_CONSTEXPR auto operator"" _svc(const char* str, std::size_t len) SVBB_NOEXC
 {
     return basic_string_view<char, constexpr_char_traits<char>>{str, len};
 }
+
+SVBB_CONSTEXPR ci_string_view operator"" _svi(const char* str, std::size_t len) SVBB_NOEXCEPT
+{
+    return ci_string_view{str, len};
+}
 }} // namespace SVBB_NAMESPACE::literals
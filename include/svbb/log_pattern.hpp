@@ -0,0 +1,169 @@
+#pragma once
+// Needs C++17, fold expressions and if constexpr compile the pattern.
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "svbb/log_pattern.hpp needs C++17"
+#endif
+#include <array>
+#include <utility>
+
+#include "svbb/config.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace detail {
+
+// The literal text of a pattern with "%%" unescaped, where each literal starts and what
+// follows it. Literal i comes before field i, the last one ends the pattern.
+template<size_t Fields, size_t Length>
+struct compiled_log_pattern
+{
+    char text[Length + 1];
+    size_t literal_begin[Fields + 1];
+    size_t literal_size[Fields + 1];
+    char kind[Fields + 1];
+    bool valid;
+};
+
+constexpr size_t log_pattern_length(const char* format)
+{
+    size_t n = 0;
+    while(format[n] != '\0')
+        ++n;
+    return n;
+}
+
+constexpr size_t log_pattern_fields(const char* format)
+{
+    size_t fields = 0;
+    for(size_t i = 0; format[i] != '\0'; ++i){
+        if(format[i] != '%')
+            continue;
+        if(format[++i] == '\0')
+            break;
+        if(format[i] != '%')
+            ++fields;
+    }
+    return fields;
+}
+
+template<size_t Fields, size_t Length>
+constexpr compiled_log_pattern<Fields, Length> compile_log_pattern(const char* format)
+{
+    compiled_log_pattern<Fields, Length> c{};
+    c.valid = true;
+    size_t size = 0;
+    size_t field = 0;
+    for(size_t i = 0; format[i] != '\0'; ++i){
+        if(format[i] != '%'){
+            c.text[size++] = format[i];
+            continue;
+        }
+        const char conversion = format[++i];
+        if(conversion == '%'){
+            c.text[size++] = '%';
+            continue;
+        }
+        if(conversion != 's' && conversion != 'd'){
+            c.valid = false;
+            return c;
+        }
+        c.literal_size[field] = size - c.literal_begin[field];
+        c.kind[field] = conversion;
+        c.literal_begin[++field] = size;
+    }
+    c.literal_size[field] = size - c.literal_begin[field];
+    // A %s ends where the text after it starts, so only the last one may be followed by none.
+    for(size_t k = 0; k + 1 < Fields; ++k){
+        if(c.kind[k] == 's' && c.literal_size[k + 1] == 0)
+            c.valid = false;
+    }
+    return c;
+}
+} // namespace detail
+
+// A line format known at compile time, made of literal text and fields:
+//   %s  any text, up to the first character of the literal text after it, or the end of the
+//       line for a %s that ends the pattern
+//   %d  an optional '-' and one or more digits
+//   %%  a literal '%'
+// The format is parsed while compiling, match() is a fixed sequence of steps with the literal
+// texts, their sizes and the characters to look for as constants:
+//   static constexpr char common_log[] = "%s %s %s [%s] \"%s\" %d %d";
+//   std::array<string_view, log_pattern<common_log>::size> f;
+//   if(log_pattern<common_log>::match(line, f))
+//       count(f[0], f[6]);
+template<const char* Format>
+class log_pattern
+{
+    static constexpr size_t length = detail::log_pattern_length(Format);
+
+public:
+    // Number of fields.
+    static constexpr size_t size = detail::log_pattern_fields(Format);
+
+    // Whether all of 'line' has the format, with 'fields' pointing into it. 'fields' is left
+    // partly filled if not.
+    template<typename CharT, typename Traits>
+    static bool match(basic_string_view<CharT, Traits> line,
+                      std::array<basic_string_view<CharT, Traits>, size>& fields)
+    {
+        return match(line, fields, std::make_index_sequence<size>());
+    }
+
+private:
+    static constexpr detail::compiled_log_pattern<size, length> compiled =
+        detail::compile_log_pattern<size, length>(Format);
+    static_assert(compiled.valid, "log_pattern only knows %s, %d and %%, and a %s that is not "
+                                  "the last field must be followed by literal text");
+
+    template<typename CharT, typename Traits, size_t... I>
+    static bool match(basic_string_view<CharT, Traits> line,
+                      std::array<basic_string_view<CharT, Traits>, size>& fields,
+                      std::index_sequence<I...>)
+    {
+        return (field<I>(line, fields[I]) && ...) && literal<size>(line) && line.empty();
+    }
+
+    template<size_t I, typename CharT, typename Traits>
+    static bool literal(basic_string_view<CharT, Traits>& rest)
+    {
+        constexpr size_t begin = compiled.literal_begin[I];
+        constexpr size_t n = compiled.literal_size[I];
+        if(rest.size() < n)
+            return false;
+        for(size_t k = 0; k < n; ++k){
+            if(!Traits::eq(rest[k], CharT(compiled.text[begin + k])))
+                return false;
+        }
+        rest.remove_prefix(n);
+        return true;
+    }
+
+    template<size_t I, typename CharT, typename Traits>
+    static bool field(basic_string_view<CharT, Traits>& rest, basic_string_view<CharT, Traits>& out)
+    {
+        if(!literal<I>(rest))
+            return false;
+        size_t end = 0;
+        if constexpr(compiled.kind[I] == 'd'){
+            if(!rest.empty() && Traits::eq(rest[0], CharT('-')))
+                end = 1;
+            const size_t digits = end;
+            while(end < rest.size() && rest[end] >= CharT('0') && rest[end] <= CharT('9'))
+                ++end;
+            if(end == digits)
+                return false;
+        } else if constexpr(compiled.literal_size[I + 1] == 0){
+            end = rest.size();
+        } else {
+            end = rest.find(CharT(compiled.text[compiled.literal_begin[I + 1]]));
+            if(end == rest.npos)
+                return false;
+        }
+        out = rest.substr(0, end);
+        rest.remove_prefix(end);
+        return true;
+    }
+};
+
+} // END NAMESPACE
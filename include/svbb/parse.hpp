@@ -0,0 +1,178 @@
+#pragma once
+// Needs C++17, the conversions are std::from_chars from <charconv>.
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "svbb/parse.hpp needs C++17"
+#endif
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "svbb/config.hpp"
+#include "svbb/tokenize.hpp"
+
+namespace SVBB_NAMESPACE {
+
+template<typename T>
+struct parse_result
+{
+    T value{};
+    // std::errc::invalid_argument if the text is not a T, std::errc::result_out_of_range if
+    // it is a number that doesn't fit.
+    std::errc error{};
+
+    SVBB_CONSTEXPR bool ok() const SVBB_NOEXCEPT { return error == std::errc(); }
+};
+
+// Number in all of 'text', converted with std::from_chars: no leading whitespace or '+', and
+// nothing may follow the number. Works on the view itself, nothing is copied.
+//   auto port = parse<std::uint16_t>(fields[2]);
+//   if(port.ok()) connect(host, port.value);
+template<typename T, typename CharT, typename Traits>
+parse_result<T> parse(basic_string_view<CharT, Traits> text)
+{
+    static_assert(std::is_same<CharT, char>::value, "parse reads char input");
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "parse converts to integer and floating point types");
+    parse_result<T> result;
+    const char* end = text.data() + text.size();
+    const auto converted = std::from_chars(text.data(), end, result.value);
+    if(converted.ec != std::errc())
+        result.error = converted.ec;
+    else if(converted.ptr != end)
+        result.error = std::errc::invalid_argument;
+    return result;
+}
+
+// What tokenize_as does with a token that is not a number of the requested type.
+enum class ON_ERROR {
+    THROW, // Throw std::invalid_argument or std::out_of_range, like std::stoi.
+    SKIP,  // Leave the token out.
+    STOP   // End the range before the token.
+};
+
+// The first token that could not be converted, and how many were skipped.
+struct parse_status
+{
+    std::errc error{};
+    size_t offset = 0;
+    size_t skipped = 0;
+
+    SVBB_CONSTEXPR bool ok() const SVBB_NOEXCEPT { return error == std::errc(); }
+};
+
+// The tokens of Range converted with parse<T>. Each token is converted once, when the
+// iterator reaches it.
+template<typename T, ON_ERROR OnError, typename Range>
+class typed_range
+{
+public:
+    using view_type = typename Range::view_type;
+    using base_iterator = typename Range::iterator;
+
+    class iterator
+    {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() : base_(), value_(), input_(nullptr), status_(nullptr) {}
+        iterator(base_iterator base, const typename view_type::value_type* input,
+                 parse_status* status)
+            : base_(base), value_(), input_(input), status_(status)
+        {
+            convert();
+        }
+
+        reference operator*() const SVBB_NOEXCEPT { return value_; }
+        pointer operator->() const SVBB_NOEXCEPT { return &value_; }
+        iterator& operator++()
+        {
+            ++base_;
+            convert();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        bool operator==(const iterator& rhs) const { return base_ == rhs.base_; }
+        bool operator!=(const iterator& rhs) const { return base_ != rhs.base_; }
+
+    private:
+        base_iterator base_;
+        T value_;
+        const typename view_type::value_type* input_;
+        parse_status* status_;
+
+        void convert()
+        {
+            for(; base_ != base_iterator(); ++base_){
+                const view_type token = *base_;
+                const auto parsed = parse<T>(token);
+                if(parsed.ok()){
+                    value_ = parsed.value;
+                    return;
+                }
+                if(OnError == ON_ERROR::THROW){
+                    const std::string text(token.data(), token.size());
+                    if(parsed.error == std::errc::result_out_of_range)
+                        throw std::out_of_range("svbb::parse: '" + text + "' is out of range");
+                    throw std::invalid_argument("svbb::parse: '" + text + "' is not a number");
+                }
+                if(status_){
+                    if(status_->ok()){
+                        status_->error = parsed.error;
+                        status_->offset = static_cast<size_t>(token.data() - input_);
+                    }
+                    if(OnError == ON_ERROR::SKIP)
+                        ++status_->skipped;
+                }
+                if(OnError == ON_ERROR::STOP){
+                    base_ = base_iterator();
+                    return;
+                }
+            }
+        }
+    };
+    using const_iterator = iterator;
+
+    typed_range(Range range, parse_status* status) : range_(std::move(range)), status_(status) {}
+
+    iterator begin() const { return iterator(range_.begin(), range_.input().data(), status_); }
+    iterator end() const { return iterator(); }
+
+private:
+    Range range_;
+    parse_status* status_;
+};
+
+// Tokens of 'view' as numbers of type T:
+//   for(double price : tokenize_as<double>(column, ','))
+// 'status', if given, records the first token that could not be converted. With
+// ON_ERROR::SKIP or ON_ERROR::STOP that is the only way to tell that there was one.
+template<typename T, ON_ERROR OnError = ON_ERROR::THROW, typename CharT, typename Traits,
+         typename Splitter>
+auto tokenize_as(basic_string_view<CharT, Traits> view, Splitter splitter,
+                 parse_status* status = nullptr)
+    -> typed_range<T, OnError, token_range<CharT, Traits, Splitter>>
+{
+    return {tokenize(view, std::move(splitter)), status};
+}
+
+template<typename T, ON_ERROR OnError = ON_ERROR::THROW, typename CharT, typename Traits>
+auto tokenize_as(basic_string_view<CharT, Traits> view, CharT delimeter,
+                 parse_status* status = nullptr)
+    -> typed_range<T, OnError, token_range<CharT, Traits, split_by_char<CharT>>>
+{
+    return tokenize_as<T, OnError>(view, split_by_char<CharT>(delimeter), status);
+}
+
+} // END NAMESPACE
@@ -0,0 +1,226 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#include "svbb/config.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SVBB_HAS_SSE2 1
+#endif
+
+namespace SVBB_NAMESPACE {
+
+// Byte scanning helpers for the tokenizers. SSE2 is used when the target has it, otherwise
+// 8 bytes at a time in a 64 bit word (SWAR).
+namespace simd {
+
+SVBB_CONSTEXPR std::uint64_t broadcast(unsigned char c) SVBB_NOEXCEPT
+{
+    return 0x0101010101010101ull * c;
+}
+
+// High bit of every byte of 'word' that is zero. Exact, no false positives from carries.
+SVBB_CONSTEXPR std::uint64_t zero_bytes(std::uint64_t word) SVBB_NOEXCEPT
+{
+    return ~(((word & 0x7f7f7f7f7f7f7f7full) + 0x7f7f7f7f7f7f7f7full) | word
+             | 0x7f7f7f7f7f7f7f7full);
+}
+
+// High bit of every byte of 'word' that equals 'c'.
+SVBB_CONSTEXPR std::uint64_t equal_bytes(std::uint64_t word, unsigned char c) SVBB_NOEXCEPT
+{
+    return zero_bytes(word ^ broadcast(c));
+}
+
+inline std::uint64_t load64(const char* p) SVBB_NOEXCEPT
+{
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+inline unsigned count_trailing_zeros(std::uint64_t bits) SVBB_NOEXCEPT
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned n = 0;
+    while(!(bits & 1)){
+        bits >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Index of the first byte flagged in a mask from zero_bytes() and friends.
+inline size_t first_byte(std::uint64_t mask) SVBB_NOEXCEPT
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return static_cast<size_t>(__builtin_clzll(mask) / 8);
+#else
+    return count_trailing_zeros(mask) / 8;
+#endif
+}
+
+// Number of ASCII characters data starts with.
+inline size_t ascii_prefix(const char* data, size_t size) SVBB_NOEXCEPT
+{
+    size_t i = 0;
+#ifdef SVBB_HAS_SSE2
+    for(; i + 16 <= size; i += 16){
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const int bits = _mm_movemask_epi8(block);
+        if(bits != 0)
+            return i + count_trailing_zeros(static_cast<std::uint64_t>(bits));
+    }
+#endif
+    for(; i + 8 <= size; i += 8){
+        const std::uint64_t high = load64(data + i) & broadcast(0x80);
+        if(high != 0)
+            return i + first_byte(high);
+    }
+    while(i < size && !(static_cast<unsigned char>(data[i]) & 0x80))
+        ++i;
+    return i;
+}
+
+// 'word' with the ASCII letters 'A' to 'Z' made lowercase, other bytes unchanged.
+SVBB_CONSTEXPR std::uint64_t ascii_lower(std::uint64_t word) SVBB_NOEXCEPT
+{
+    // Adding to the low 7 bits of each byte sets its high bit from 'A' on in the first sum and
+    // past 'Z' in the second, without carries between bytes. Where they differ is a capital,
+    // unless the byte itself had the high bit set; its 0x80 moved to 0x20 is the case bit.
+    return word | ((((word & 0x7f7f7f7f7f7f7f7full) + broadcast(0x80 - 'A'))
+                    ^ ((word & 0x7f7f7f7f7f7f7f7full) + broadcast(0x80 - 'Z' - 1)))
+                   & ~word & broadcast(0x80)) >> 2;
+}
+
+#ifdef SVBB_HAS_SSE2
+inline __m128i ascii_lower(__m128i block) SVBB_NOEXCEPT
+{
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                                        _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+// Index of the first of data[0, size) that is one of set[0, set_size), or 'size'.
+// Meant for short sets, every block is compared against each of them.
+inline size_t find_first_of(const char* data, size_t size, const char* set,
+                            size_t set_size) SVBB_NOEXCEPT
+{
+    size_t i = 0;
+#ifdef SVBB_HAS_SSE2
+    for(; i + 16 <= size; i += 16){
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i found = _mm_setzero_si128();
+        for(size_t k = 0; k < set_size; ++k)
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(block, _mm_set1_epi8(set[k])));
+        const int bits = _mm_movemask_epi8(found);
+        if(bits != 0)
+            return i + count_trailing_zeros(static_cast<std::uint64_t>(bits));
+    }
+#endif
+    for(; i + 8 <= size; i += 8){
+        const std::uint64_t word = load64(data + i);
+        std::uint64_t found = 0;
+        for(size_t k = 0; k < set_size; ++k)
+            found |= equal_bytes(word, static_cast<unsigned char>(set[k]));
+        if(found != 0)
+            return i + first_byte(found);
+    }
+    for(; i < size; ++i){
+        for(size_t k = 0; k < set_size; ++k){
+            if(data[i] == set[k])
+                return i;
+        }
+    }
+    return size;
+}
+
+// Bit i of the result is the xor of bits 0 to i of 'bits'. Turns a mask of quotes into a mask
+// of what lies between them.
+SVBB_CXX14_CONSTEXPR std::uint64_t prefix_xor(std::uint64_t bits) SVBB_NOEXCEPT
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Characters escaped by a backslash, given the mask of backslashes of a 64 byte block: those
+// after an odd number of backslashes in a row. 'carry' is true if the last backslash of the
+// previous block escapes the first character of this one, it is updated for the next block.
+SVBB_CXX14_CONSTEXPR std::uint64_t escaped_bits(std::uint64_t backslash,
+                                                std::uint64_t& carry) SVBB_NOEXCEPT
+{
+    constexpr std::uint64_t even_bits = 0x5555555555555555ull;
+    backslash &= ~carry;
+    const std::uint64_t follows_escape = (backslash << 1) | carry;
+    // Adding the starts of runs on odd positions to the backslashes carries through each
+    // run, leaving a bit after it. Runs starting on even positions are left as they were.
+    const std::uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    const std::uint64_t sum = odd_starts + backslash;
+    carry = (sum < odd_starts) ? 1 : 0;
+    const std::uint64_t invert = sum << 1;
+    return (even_bits ^ invert) & follows_escape;
+}
+
+// 64 bytes loaded once and compared against several characters.
+class block64
+{
+public:
+    explicit block64(const char* data) SVBB_NOEXCEPT
+    {
+#ifdef SVBB_HAS_SSE2
+        for(int i = 0; i < 4; ++i)
+            chunks_[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+#else
+        for(int i = 0; i < 8; ++i)
+            words_[i] = load64(data + 8 * i);
+#endif
+    }
+
+    // Bit i is set where byte i equals 'c'.
+    std::uint64_t equal(char c) const SVBB_NOEXCEPT
+    {
+#ifdef SVBB_HAS_SSE2
+        const __m128i needle = _mm_set1_epi8(c);
+        std::uint64_t bits = 0;
+        for(int i = 0; i < 4; ++i){
+            const int found = _mm_movemask_epi8(_mm_cmpeq_epi8(chunks_[i], needle));
+            bits |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(found)) << (16 * i);
+        }
+        return bits;
+#else
+        std::uint64_t bits = 0;
+        for(int i = 0; i < 8; ++i)
+            bits |= byte_bits(equal_bytes(words_[i], static_cast<unsigned char>(c))) << (8 * i);
+        return bits;
+#endif
+    }
+
+private:
+#ifdef SVBB_HAS_SSE2
+    __m128i chunks_[4];
+#else
+    std::uint64_t words_[8];
+
+    // Gather the high bits of the bytes of a mask into the low 8 bits, in memory order.
+    static std::uint64_t byte_bits(std::uint64_t mask) SVBB_NOEXCEPT
+    {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        mask = __builtin_bswap64(mask);
+#endif
+        return ((mask >> 7) * 0x0102040810204080ull) >> 56;
+    }
+#endif
+};
+
+} // namespace simd
+} // namespace SVBB_NAMESPACE
@@ -1,6 +1,7 @@
 #pragma once
 #include "config.hpp"
 #include <algorithm>
+#include <array>
 
 namespace SVBB_NAMESPACE {
 
@@ -89,5 +90,50 @@ SVBB_CXX14_CONSTEXPR auto split_after(basic_string_view<CharT, Traits> input,
     return split_at(input, std::min(input.find_first_of(delim), input.size()) + 1 );
 }
 
+template<typename CharT, typename Traits, size_t N>
+struct split_n_result;
+
+// Split 'input' into N fields at the first N-1 delimiters, the last field keeps the rest.
+// N is a constant, so the loop over the N-1 searches can be unrolled, and nothing is
+// allocated:
+//   auto r = split_n<3>("2024-05-17"_sv, '-');
+//   if(r.complete()) use(r.fields[0], r.fields[1], r.fields[2]);
+template<size_t N, typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto split_n(basic_string_view<CharT, Traits> input, CharT delim)
+    -> split_n_result<CharT, Traits, N>
+{
+    static_assert(N > 0, "split_n needs at least one field");
+    split_n_result<CharT, Traits, N> result;
+    result.split(input, delim);
+    return result;
+}
+
+// Fields of a split_n. count is the number of fields found, N unless the input has fewer
+// than N-1 delimiters. The fields after count are empty.
+template<typename CharT, typename Traits, size_t N>
+struct split_n_result
+{
+    std::array<basic_string_view<CharT, Traits>, N> fields{};
+    size_t count = 0;
+
+    SVBB_CONSTEXPR bool complete() const SVBB_NOEXCEPT { return count == N; }
+
+private:
+    template<size_t M, typename C, typename T>
+    friend SVBB_CXX14_CONSTEXPR auto split_n(basic_string_view<C, T> input, C delim)
+        -> split_n_result<C, T, M>;
+
+    SVBB_CXX14_CONSTEXPR void split(basic_string_view<CharT, Traits> rest, CharT delim)
+    {
+        for(; count + 1 < N; ++count){
+            const size_t pos = rest.find(delim);
+            if(pos == rest.npos)
+                break;
+            fields[count] = rest.substr(0, pos);
+            rest.remove_prefix(pos + 1);
+        }
+        fields[count++] = rest;
+    }
+};
 
 } // namespace SVBB_NAMESPACE
@@ -25,6 +25,7 @@ public:
         return remainder().empty() && token().empty();
     }
     SVBB_CXX14_CONSTEXPR void split() { data_ = splitter_(remainder()); }
+    SVBB_CONSTEXPR const Splitter& splitter() const SVBB_NOEXCEPT { return splitter_; }
 
 private:
     split_result<CharT, Traits> data_;
@@ -77,7 +78,9 @@ public:
         return !(*this == rhs);
     }
 
-    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return state_ != nullptr; }
+    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return !state_.empty(); }
+    // The splitter that produced the current token, for splitters that keep more about it.
+    SVBB_CONSTEXPR const Splitter& splitter() const SVBB_NOEXCEPT { return state_.splitter(); }
 
 private:
     state_type state_;
@@ -1,7 +1,10 @@
 #pragma once
+#include <iterator>
+
 #include "svbb/config.hpp"
 #include "svbb/token_iterator.hpp"
 #include "svbb/trim.hpp"
+#include "svbb/utf8.hpp"
 
 namespace SVBB_NAMESPACE {
 
@@ -13,16 +16,21 @@ public:
     using const_iterator = iterator;
     using view_type = typename iterator::view_type;
 
+    SVBB_CONSTEXPR token_range() = default;
     SVBB_CONSTEXPR token_range(view_type view, Splitter splitter)
-        : begin_(view, std::move(splitter))
+        : view_(view), splitter_(std::move(splitter))
     {
     }
 
-    SVBB_CONSTEXPR auto begin() const SVBB_NOEXCEPT -> iterator { return begin_; }
+    SVBB_CXX14_CONSTEXPR auto begin() const -> iterator { return iterator(view_, splitter_); }
     SVBB_CONSTEXPR auto end() const SVBB_NOEXCEPT -> iterator { return iterator(); }
 
+    SVBB_CONSTEXPR view_type input() const SVBB_NOEXCEPT { return view_; }
+    SVBB_CONSTEXPR const Splitter& splitter() const SVBB_NOEXCEPT { return splitter_; }
+
 private:
-    iterator begin_;
+    view_type view_;
+    Splitter splitter_;
 };
 
 template<typename CharT>
@@ -85,6 +93,46 @@ private:
     CharT delimeter_;
 };
 
+// Validates the UTF-8 of everything 'Splitter' consumes, in the same pass. Tokenizing stops
+// before the first token that contains an invalid sequence, its offset is reported to
+// 'status'.
+template<typename Splitter>
+class utf8_checked
+{
+public:
+    utf8_checked() : splitter_(), status_(nullptr) {}
+    utf8_checked(Splitter splitter, utf8::status& status)
+        : splitter_(std::move(splitter)), status_(&status)
+    {
+    }
+
+    template<typename CharT, typename Traits>
+    auto operator()(basic_string_view<CharT, Traits> input) -> split_result<CharT, Traits>
+    {
+        if(!validator_.valid())
+            return {};
+        auto splitted = splitter_(input);
+        if(!validator_.feed(input.substr(0, input.size() - splitted.right.size()))
+            || (splitted.right.empty() && !validator_.finish())){
+            status_->error_offset = validator_.error_offset();
+            return {};
+        }
+        return splitted;
+    }
+
+private:
+    Splitter splitter_;
+    // Every copy of the iterator validates on its own, they all report the same error.
+    utf8::validator validator_;
+    utf8::status* status_;
+};
+
+template<typename Splitter>
+auto check_utf8(Splitter splitter, utf8::status& status) -> utf8_checked<Splitter>
+{
+    return utf8_checked<Splitter>(std::move(splitter), status);
+}
+
 template<typename CharT, typename Traits, typename Splitter>
 SVBB_CXX14_CONSTEXPR auto tokenize(basic_string_view<CharT, Traits> view, Splitter splitter)
     -> token_range<CharT, Traits, Splitter>
@@ -114,3 +162,15 @@ SVBB_CXX14_CONSTEXPR auto tokenize(basic_string_view<CharT, Traits> view, CharT
     return tokenize(view, split_by_char_and_trim<CharT, Traits>(delimeter, whitespace));
 }
 } // namespace SVBB_NAMESPACE
+
+#if defined(__cpp_lib_ranges)
+namespace std::ranges {
+// Iterators own a copy of the input view and splitter, they don't refer to the range.
+template<typename CharT, typename Traits, typename Splitter>
+inline constexpr bool
+    enable_borrowed_range<SVBB_NAMESPACE::token_range<CharT, Traits, Splitter>> = true;
+template<typename CharT, typename Traits, typename Splitter>
+inline constexpr bool
+    enable_view<SVBB_NAMESPACE::token_range<CharT, Traits, Splitter>> = true;
+} // namespace std::ranges
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 #include "svbb/config.hpp"
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 namespace SVBB_NAMESPACE {
 template<typename CharT, typename Traits>
@@ -53,4 +55,78 @@ SVBB_CXX14_CONSTEXPR auto trim(basic_string_view<CharT, Traits> to_trim,
 {
     return trim_left(trim_right(to_trim, with), with);
 }
+
+// A set of characters below 256 as a bit table, so testing a character is a lookup instead of
+// a search through the characters to trim with. Wider characters are never in the set.
+//   const char_set whitespace(" \t\r\n");
+//   auto value = trim(field, whitespace);
+class char_set
+{
+public:
+    // The empty set.
+    SVBB_CONSTEXPR char_set() SVBB_NOEXCEPT {}
+    SVBB_CXX14_CONSTEXPR explicit char_set(const char* chars)
+    {
+        for(; *chars != '\0'; ++chars)
+            insert(*chars);
+    }
+    template<typename CharT, typename Traits>
+    SVBB_CXX14_CONSTEXPR explicit char_set(basic_string_view<CharT, Traits> chars)
+    {
+        for(size_t i = 0; i < chars.size(); ++i)
+            insert(chars[i]);
+    }
+
+    template<typename CharT>
+    SVBB_CXX14_CONSTEXPR void insert(CharT c)
+    {
+        const auto u = to_unsigned(c);
+        if(u < 256)
+            bits_[u >> 6] |= std::uint64_t(1) << (u & 63);
+    }
+    template<typename CharT>
+    SVBB_CXX14_CONSTEXPR bool contains(CharT c) const
+    {
+        const auto u = to_unsigned(c);
+        return u < 256 && ((bits_[u >> 6] >> (u & 63)) & 1) != 0;
+    }
+
+private:
+    std::uint64_t bits_[4] = {0, 0, 0, 0};
+
+    template<typename CharT>
+    static SVBB_CONSTEXPR typename std::make_unsigned<CharT>::type to_unsigned(CharT c)
+    {
+        return static_cast<typename std::make_unsigned<CharT>::type>(c);
+    }
+};
+
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto trim_left(basic_string_view<CharT, Traits> to_trim, const char_set& with)
+    -> basic_string_view<CharT, Traits>
+{
+    size_t n = 0;
+    while(n < to_trim.size() && with.contains(to_trim[n]))
+        ++n;
+    to_trim.remove_prefix(n);
+    return to_trim;
+}
+
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto trim_right(basic_string_view<CharT, Traits> to_trim, const char_set& with)
+    -> basic_string_view<CharT, Traits>
+{
+    size_t n = to_trim.size();
+    while(n > 0 && with.contains(to_trim[n - 1]))
+        --n;
+    to_trim.remove_suffix(to_trim.size() - n);
+    return to_trim;
+}
+
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto trim(basic_string_view<CharT, Traits> to_trim, const char_set& with)
+    -> basic_string_view<CharT, Traits>
+{
+    return trim_left(trim_right(to_trim, with), with);
+}
 } // namespace SVBB_NAMESPACE
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+
+#include "svbb/config.hpp"
+#include "svbb/simd.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace utf8 {
+
+// Checks that input is well formed UTF-8: no overlong forms, surrogates, code points above
+// U+10FFFF or truncated sequences. The input may be fed in pieces, sequences can span them.
+// Runs of ASCII are skipped a block at a time, the rest goes through a small state machine.
+class validator
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Validate the next 'size' bytes. Returns false once an error has been found.
+    bool feed(const char* data, size_t size) SVBB_NOEXCEPT
+    {
+        if(!valid())
+            return false;
+        size_t i = 0;
+        while(i < size){
+            if(need_ == 0){
+                i += simd::ascii_prefix(data + i, size - i);
+                if(i == size)
+                    break;
+                start_ = offset_ + i;
+                if(!lead(static_cast<unsigned char>(data[i])))
+                    return fail();
+            } else {
+                const auto c = static_cast<unsigned char>(data[i]);
+                if(c < low_ || c > high_)
+                    return fail();
+                low_ = 0x80;
+                high_ = 0xbf;
+                --need_;
+            }
+            ++i;
+        }
+        offset_ += size;
+        return true;
+    }
+
+    template<typename CharT, typename Traits>
+    bool feed(basic_string_view<CharT, Traits> input) SVBB_NOEXCEPT
+    {
+        static_assert(sizeof(CharT) == 1, "UTF-8 is validated on byte strings");
+        return feed(reinterpret_cast<const char*>(input.data()), input.size());
+    }
+
+    // The input is complete. False if it ends within a sequence.
+    bool finish() SVBB_NOEXCEPT
+    {
+        if(valid() && need_ != 0)
+            return fail();
+        return valid();
+    }
+
+    bool valid() const SVBB_NOEXCEPT { return error_ == npos; }
+    // Offset of the first byte of the first invalid sequence, npos if there is none.
+    size_t error_offset() const SVBB_NOEXCEPT { return error_; }
+    // Bytes fed so far.
+    size_t size() const SVBB_NOEXCEPT { return offset_; }
+
+private:
+    size_t offset_ = 0;
+    size_t start_ = 0;
+    size_t error_ = npos;
+    unsigned need_ = 0;
+    unsigned char low_ = 0x80;
+    unsigned char high_ = 0xbf;
+
+    bool fail() SVBB_NOEXCEPT
+    {
+        error_ = start_;
+        return false;
+    }
+
+    // Start a sequence, the second byte gets the range that excludes the invalid forms.
+    bool lead(unsigned char c) SVBB_NOEXCEPT
+    {
+        low_ = 0x80;
+        high_ = 0xbf;
+        if(c >= 0xc2 && c <= 0xdf){
+            need_ = 1;
+        } else if(c >= 0xe0 && c <= 0xef){
+            need_ = 2;
+            if(c == 0xe0)
+                low_ = 0xa0; // overlong
+            else if(c == 0xed)
+                high_ = 0x9f; // surrogates
+        } else if(c >= 0xf0 && c <= 0xf4){
+            need_ = 3;
+            if(c == 0xf0)
+                low_ = 0x90; // overlong
+            else if(c == 0xf4)
+                high_ = 0x8f; // above U+10FFFF
+        } else {
+            return false;
+        }
+        return true;
+    }
+};
+
+// Where validation that runs inside another component reports errors.
+struct status
+{
+    size_t error_offset = validator::npos;
+
+    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return error_offset == validator::npos; }
+};
+
+// Offset of the first invalid sequence of 'input', validator::npos if it is valid.
+template<typename CharT, typename Traits>
+size_t validate(basic_string_view<CharT, Traits> input) SVBB_NOEXCEPT
+{
+    validator v;
+    v.feed(input);
+    v.finish();
+    return v.error_offset();
+}
+
+} // namespace utf8
+} // namespace SVBB_NAMESPACE
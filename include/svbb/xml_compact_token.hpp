@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+
+#include "svbb/config.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+// 16 byte stand-in for token when tokens are buffered. Names and values are stored as offsets
+// from the start of a base view and only turned back into views on access. The base is the
+// document or, for buffers of part of a large one, a view starting where that part does; it
+// has to be the same for make() and the accessors. What doesn't fit, a token ending 4 GiB or
+// more after the base or a name of 64 KiB or more, is rejected with std::length_error.
+// ERROR tokens point at their message instead of into the document, they keep only the kind.
+struct compact_token
+{
+    // Largest offset of the end of a name or value from the base.
+    static constexpr size_t max_offset = UINT32_MAX;
+    static constexpr size_t max_qname_size = UINT16_MAX;
+
+    std::uint32_t qname_offset = 0;
+    std::uint32_t value_offset = 0;
+    std::uint32_t value_size = 0;
+    std::uint16_t qname_size = 0;
+    std::uint8_t kind = static_cast<std::uint8_t>(ELEMENT::END_DOCUMENT);
+
+    SVBB_CONSTEXPR ELEMENT element() const SVBB_NOEXCEPT { return static_cast<ELEMENT>(kind); }
+
+    template<typename CharT, typename Traits>
+    static compact_token make(const token<CharT, Traits>& t,
+                              basic_string_view<CharT, Traits> document)
+    {
+        compact_token result;
+        result.kind = static_cast<std::uint8_t>(t.element);
+        if(t.element == ELEMENT::ERROR)
+            return result;
+
+        if(!t.qname.empty()){
+            if(t.qname.size() > max_qname_size)
+                throw std::length_error("svbb::xml::compact_token: name too long");
+            result.qname_offset = offset(t.qname, document);
+            result.qname_size = static_cast<std::uint16_t>(t.qname.size());
+        }
+        if(!t.value.empty()){
+            result.value_offset = offset(t.value, document);
+            result.value_size = static_cast<std::uint32_t>(t.value.size());
+        }
+        return result;
+    }
+
+    template<typename CharT, typename Traits>
+    SVBB_CONSTEXPR auto qname(basic_string_view<CharT, Traits> document) const
+        -> basic_string_view<CharT, Traits>
+    {
+        return document.substr(qname_offset, qname_size);
+    }
+
+    template<typename CharT, typename Traits>
+    SVBB_CONSTEXPR auto value(basic_string_view<CharT, Traits> document) const
+        -> basic_string_view<CharT, Traits>
+    {
+        return document.substr(value_offset, value_size);
+    }
+
+    template<typename CharT, typename Traits>
+    auto expand(basic_string_view<CharT, Traits> document, int depth = 0) const
+        -> token<CharT, Traits>
+    {
+        token<CharT, Traits> result(element(), qname(document), value(document));
+        result.depth = depth;
+        return result;
+    }
+
+private:
+    template<typename CharT, typename Traits>
+    static std::uint32_t offset(basic_string_view<CharT, Traits> part,
+                                basic_string_view<CharT, Traits> document)
+    {
+        SVBB_ASSERT(part.data() >= document.data()
+                    && part.data() + part.size() <= document.data() + document.size());
+        const size_t begin = static_cast<size_t>(part.data() - document.data());
+        if(begin + part.size() > max_offset)
+            throw std::length_error("svbb::xml::compact_token: token too far from its base");
+        return static_cast<std::uint32_t>(begin);
+    }
+};
+
+static_assert(sizeof(compact_token) == 16, "compact_token is meant to fit 4 in a cache line");
+
+template<typename OSTREAM>
+OSTREAM& operator<<(OSTREAM& os, const compact_token& obj)
+{
+    os << obj.element() << ", qname=" << obj.qname_size << "@" << obj.qname_offset
+       << ", value=" << obj.value_size << "@" << obj.value_offset;
+    return os;
+}
+
+}
+
+} // END NAMESPACE
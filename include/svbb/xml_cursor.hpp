@@ -0,0 +1,83 @@
+#pragma once
+#include "svbb/config.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+// Single pass pull parser over a document:
+//   auto c = xml::make_cursor(document);
+//   while(c.next()){
+//       switch(c.kind()){ case ELEMENT::START_ELEMENT: use(c.name()); break; ... }
+//   }
+// Unlike token_iterator the state stays in place, the current token is read through
+// references and the cursor can be moved but not copied.
+template<typename CharT, typename Traits, typename Policy = default_policy>
+class cursor
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using token_type = token<CharT, Traits>;
+    using state_type = detail::token_state<CharT, Traits, Policy>;
+
+    SVBB_CONSTEXPR explicit cursor(view_type document) : state_(document) {}
+
+    cursor(const cursor&) = delete;
+    cursor& operator=(const cursor&) = delete;
+    cursor(cursor&&) = default;
+    cursor& operator=(cursor&&) = default;
+
+    // Move to the next token. Returns false once END_DOCUMENT or ERROR has been reported.
+    SVBB_CXX14_CONSTEXPR bool next()
+    {
+        if(state_.empty())
+            return false;
+        state_.split();
+        return true;
+    }
+
+    SVBB_CONSTEXPR ELEMENT kind() const SVBB_NOEXCEPT { return state_.current_token().element; }
+    // qname of elements and attributes, target of processing instructions.
+    SVBB_CONSTEXPR const view_type& name() const SVBB_NOEXCEPT
+    {
+        return state_.current_token().qname;
+    }
+    // Attribute values, text, comments, processing instruction data and error messages.
+    SVBB_CONSTEXPR const view_type& value() const SVBB_NOEXCEPT
+    {
+        return state_.current_token().value;
+    }
+    // Number of open elements, START_ELEMENT included and END_ELEMENT excluded.
+    SVBB_CONSTEXPR size_t depth() const SVBB_NOEXCEPT { return state_.depth(); }
+    SVBB_CONSTEXPR const token_type& current() const SVBB_NOEXCEPT
+    {
+        return state_.current_token();
+    }
+    // See token_state::utf8_error_offset().
+    SVBB_CONSTEXPR size_t utf8_error_offset() const SVBB_NOEXCEPT
+    {
+        return state_.utf8_error_offset();
+    }
+
+    // See token_iterator::skip_subtree() and token_iterator::skip_to_element().
+    SVBB_CXX14_CONSTEXPR bool skip_subtree() { return state_.skip_subtree(); }
+    SVBB_CXX14_CONSTEXPR bool skip_to_element(view_type qname)
+    {
+        return state_.skip_to_element(qname);
+    }
+
+private:
+    state_type state_;
+};
+
+template<typename Policy = default_policy, typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto make_cursor(basic_string_view<CharT, Traits> document)
+    -> cursor<CharT, Traits, Policy>
+{
+    return cursor<CharT, Traits, Policy>(document);
+}
+
+}
+
+} // END NAMESPACE
@@ -0,0 +1,207 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "svbb/config.hpp"
+#include "svbb/hash.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+namespace detail {
+SVBB_CONSTEXPR size_t next_pow2(size_t n, size_t p = 1) { return p >= n ? p : next_pow2(n, p * 2); }
+} // namespace detail
+
+// Perfect hash from a fixed list of element and attribute names to their index in the list.
+// Built with hash and displace: names are hashed into buckets, and every bucket gets the
+// smallest displacement that moves all of its names to free slots. A lookup costs one hash of
+// the name and one compare to confirm it. Meant to be built at compile time:
+//   constexpr auto names = make_name_table("feed"_sv, "entry"_sv, "price"_sv);
+//   switch(names.id(qname)) { case names.id("price"_sv): ... }
+template<typename CharT, typename Traits, size_t N>
+class name_table
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+
+    // Id of names that aren't in the table.
+    static constexpr size_t npos = N;
+    static constexpr size_t slot_count = detail::next_pow2(2 * N);
+
+    SVBB_CXX14_CONSTEXPR explicit name_table(const std::array<view_type, N>& names)
+        : names_(names), slots_(), displacement_(), seed_(0)
+    {
+        static_assert(N > 0, "name_table needs at least one name");
+        // Only fails for duplicate names.
+        while(!build() && ++seed_ < max_seeds_) {}
+        SVBB_ASSERT(seed_ < max_seeds_);
+    }
+
+    SVBB_CONSTEXPR size_t size() const SVBB_NOEXCEPT { return N; }
+    SVBB_CONSTEXPR view_type name(size_t id) const { return names_[id]; }
+
+    SVBB_CXX14_CONSTEXPR size_t id(view_type name) const SVBB_NOEXCEPT
+    {
+        const std::uint64_t hash = fnv1a(name, seed_);
+        const size_t id = slots_[slot(hash, displacement_[bucket(hash)])];
+        return (id != npos && names_[id] == name) ? id : npos;
+    }
+
+private:
+    static constexpr std::uint64_t max_seeds_ = 64;
+
+    std::array<view_type, N> names_;
+    std::array<std::uint32_t, slot_count> slots_;
+    std::array<std::uint32_t, N> displacement_;
+    std::uint64_t seed_;
+
+    static SVBB_CONSTEXPR size_t bucket(std::uint64_t hash) { return (hash >> 40) % N; }
+    static SVBB_CONSTEXPR size_t slot(std::uint64_t hash, std::uint64_t displacement)
+    {
+        // (hash >> 32) | 1 is odd, so the displacements reach every slot.
+        return static_cast<size_t>(hash + displacement * ((hash >> 32) | 1)) & (slot_count - 1);
+    }
+
+    SVBB_CXX14_CONSTEXPR bool build()
+    {
+        std::array<std::uint64_t, N> hashes{};
+        std::array<size_t, N> bucket_size{};
+        for(size_t i = 0; i < N; ++i){
+            hashes[i] = fnv1a(names_[i], seed_);
+            ++bucket_size[bucket(hashes[i])];
+        }
+        for(size_t s = 0; s < slot_count; ++s)
+            slots_[s] = npos;
+
+        // Largest buckets first, they are the hardest to place.
+        for(size_t size = N; size > 0; --size){
+            for(size_t b = 0; b < N; ++b){
+                if(bucket_size[b] == size && !place(b, hashes))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    SVBB_CXX14_CONSTEXPR bool place(size_t b, const std::array<std::uint64_t, N>& hashes)
+    {
+        for(std::uint32_t d = 0; d < 4 * slot_count; ++d){
+            bool fits = true;
+            for(size_t i = 0; i < N && fits; ++i){
+                if(bucket(hashes[i]) != b)
+                    continue;
+                const size_t s = slot(hashes[i], d);
+                fits = (slots_[s] == npos);
+                // Names of the same bucket may collide with each other.
+                for(size_t j = 0; j < i && fits; ++j)
+                    fits = !(bucket(hashes[j]) == b && slot(hashes[j], d) == s);
+            }
+            if(fits){
+                for(size_t i = 0; i < N; ++i){
+                    if(bucket(hashes[i]) == b)
+                        slots_[slot(hashes[i], d)] = static_cast<std::uint32_t>(i);
+                }
+                displacement_[b] = d;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template<typename CharT, typename Traits, typename... Names>
+SVBB_CXX14_CONSTEXPR auto make_name_table(basic_string_view<CharT, Traits> first, Names... rest)
+    -> name_table<CharT, Traits, 1 + sizeof...(Names)>
+{
+    return name_table<CharT, Traits, 1 + sizeof...(Names)>(
+        std::array<basic_string_view<CharT, Traits>, 1 + sizeof...(Names)>{{first, rest...}});
+}
+
+// token with the id of its qname in a name_table, name_table::npos for unknown names and
+// tokens without a qname.
+template<typename CharT, typename Traits>
+struct named_token : token<CharT, Traits>
+{
+    size_t name_id;
+
+    named_token(const token<CharT, Traits>& t, size_t id) : token<CharT, Traits>(t), name_id(id) {}
+};
+
+template<typename CharT, typename Traits, size_t N>
+class named_token_iterator
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using value_type = named_token<CharT, Traits>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+    using iterator_category = std::forward_iterator_tag;
+    using table_type = name_table<CharT, Traits, N>;
+
+    SVBB_CONSTEXPR named_token_iterator() SVBB_NOEXCEPT : names_(nullptr) {}
+    named_token_iterator(view_type input, const table_type* names) : it_(input), names_(names) {}
+
+    reference operator*() const
+    {
+        const auto t = *it_;
+        return {t, t.qname.empty() ? table_type::npos : names_->id(t.qname)};
+    }
+    named_token_iterator& operator++()
+    {
+        ++it_;
+        return *this;
+    }
+    named_token_iterator operator++(int)
+    {
+        named_token_iterator tmp = *this;
+        ++it_;
+        return tmp;
+    }
+
+    SVBB_CONSTEXPR bool operator==(const named_token_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return it_ == rhs.it_;
+    }
+    SVBB_CONSTEXPR bool operator!=(const named_token_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    token_iterator<CharT, Traits> it_;
+    const table_type* names_;
+};
+
+template<typename CharT, typename Traits, size_t N>
+class named_token_range
+{
+public:
+    using iterator = named_token_iterator<CharT, Traits, N>;
+    using const_iterator = iterator;
+    using view_type = typename iterator::view_type;
+    using table_type = name_table<CharT, Traits, N>;
+
+    named_token_range(view_type view, const table_type& names) : view_(view), names_(names) {}
+
+    // Iterators refer to the table owned by the range.
+    auto begin() const -> iterator { return iterator(view_, &names_); }
+    SVBB_CONSTEXPR auto end() const SVBB_NOEXCEPT -> iterator { return iterator(); }
+
+private:
+    view_type view_;
+    table_type names_;
+};
+
+template<typename CharT, typename Traits, size_t N>
+auto tokenize(basic_string_view<CharT, Traits> view, const name_table<CharT, Traits, N>& names)
+    -> named_token_range<CharT, Traits, N>
+{
+    return named_token_range<CharT, Traits, N>(view, names);
+}
+
+}
+
+} // END NAMESPACE
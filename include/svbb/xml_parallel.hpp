@@ -0,0 +1,222 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/xml_tokenizer.hpp"
+#include "svbb/xml_compact_token.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+namespace detail {
+
+// Tokens of one chunk of the document together with the state machine position around each
+// of them, marks[i] is the position before tokens[i] is split and marks[i + 1] the one after.
+// The offsets of the tokens count from 'base', where the chunk starts in the document.
+template<typename CharT, typename Traits>
+struct speculative_chunk
+{
+    using state_type = token_state<CharT, Traits>;
+    using resume_point = typename state_type::resume_point;
+
+    struct mark
+    {
+        resume_point where;
+        size_t depth;
+    };
+
+    size_t base = 0;
+    std::vector<compact_token> tokens;
+    std::vector<mark> marks;
+    state_type last;
+    bool complete = false;
+};
+
+// Depth a speculative chunk starts at. It only has to be large enough to never reach zero,
+// the real depth is stitched in afterwards.
+constexpr size_t speculative_depth = size_t(1) << 24;
+
+// Split tokens until the state machine has moved past 'end', or to the end of the document
+// if 'end' is nullptr, handing the state to 'emit' after every token. Returns false if a split didn't move the state machine, which a
+// speculative start inside a comment or processing instruction can run into.
+template<typename CharT, typename Traits, typename Emit>
+bool run_chunk(token_state<CharT, Traits>& state, const CharT* end, bool speculative, Emit emit)
+{
+    bool after_end_element = false;
+    while(!state.empty() && (!end || state.remainder().data() < end)){
+        // Behind the root element of a speculative chunk only the trailing whitespace is left.
+        if(speculative && after_end_element
+           && state.remainder().find('<') == basic_string_view<CharT, Traits>::npos)
+            break;
+
+        const auto before = state.where();
+        state.split();
+        if(!state.empty() && state.where() == before)
+            return false;
+        after_end_element = (state.last_token().element == ELEMENT::END_ELEMENT);
+        emit(state);
+    }
+    return true;
+}
+
+template<typename CharT, typename Traits>
+void run_sequential(token_state<CharT, Traits>& state, const CharT* end,
+                    std::vector<token<CharT, Traits>>& tokens)
+{
+    auto emit = [&tokens](const token_state<CharT, Traits>& s) {
+        tokens.push_back(s.last_token());
+        tokens.back().depth = static_cast<int>(s.depth());
+    };
+    if(!run_chunk(state, end, false, emit)){
+        state.setError("Tokenizer made no progress.");
+        emit(state);
+    }
+}
+
+template<typename CharT, typename Traits>
+void run_speculative(basic_string_view<CharT, Traits> document, size_t begin, size_t end,
+                     speculative_chunk<CharT, Traits>& chunk)
+{
+    using state_type = token_state<CharT, Traits>;
+    try {
+        chunk.base = begin;
+        const auto base = document.substr(begin);
+        chunk.last = state_type(document.substr(begin + 1), speculative_depth);
+        // Errors of a chunk that started in the wrong place are expected, those of a chunk
+        // that is used are reported when it is stitched in.
+        chunk.last.set_log_errors(false);
+        chunk.marks.push_back({chunk.last.where(), chunk.last.depth()});
+        chunk.complete =
+            run_chunk(chunk.last, document.data() + end, true, [&](const state_type& state) {
+                chunk.tokens.push_back(compact_token::make(state.last_token(), base));
+                chunk.marks.push_back({state.where(), state.depth()});
+            });
+    }
+    catch(...) {
+        // Started somewhere the tokenizer can't cope with, or a token did not fit a
+        // compact_token, the chunk is re-run in order.
+        chunk.complete = false;
+    }
+}
+} // namespace detail
+
+// Tokenize one document on several threads. The document is cut at '<' into chunks which are
+// tokenized speculatively, each assuming it starts at a tag of unknown depth. Afterwards the
+// chunks are stitched in order: a chunk is used from the first position where its state
+// machine agrees with the real end state of its predecessor, with its depth corrected. Chunks
+// that never agree, for example because they started inside a comment, are tokenized again
+// from the real state.
+// Returns the tokens tokenize(document) iterates over followed by the END_DOCUMENT or ERROR
+// token that ended the document, with depth set to the number of open elements after each.
+template<typename CharT, typename Traits>
+auto parallel_tokenize(basic_string_view<CharT, Traits> document, size_t threads = 0,
+                       size_t min_chunk = size_t(1) << 16)
+    -> std::vector<token<CharT, Traits>>
+{
+    using view_type = basic_string_view<CharT, Traits>;
+    using state_type = detail::token_state<CharT, Traits>;
+    using chunk_type = detail::speculative_chunk<CharT, Traits>;
+    using token_type = token<CharT, Traits>;
+
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // Chunks are kept small enough for the offsets of compact_token.
+    const size_t chunk_count = std::max<size_t>(
+        {1, std::min(threads, document.size() / std::max<size_t>(min_chunk, 1)),
+         document.size() / (compact_token::max_offset / 2) + 1});
+
+    // Chunk i is [bounds[i], bounds[i + 1]), every chunk but the first starts at a '<'.
+    std::vector<size_t> bounds{0};
+    for(size_t i = 1; i < chunk_count; ++i){
+        auto pos = document.find('<', i * document.size() / chunk_count);
+        if(pos == view_type::npos)
+            break;
+        if(pos > bounds.back())
+            bounds.push_back(pos);
+    }
+    bounds.push_back(document.size());
+
+    std::vector<token_type> tokens;
+
+    std::vector<chunk_type> chunks(bounds.size() - 1);
+    state_type state(document);
+    {
+        std::vector<std::thread> workers;
+        for(size_t i = 1; i < chunks.size(); ++i)
+            workers.emplace_back(detail::run_speculative<CharT, Traits>, document, bounds[i],
+                                 bounds[i + 1], std::ref(chunks[i]));
+
+        try {
+            detail::run_sequential(state, document.data() + bounds[1], tokens);
+        }
+        catch(...) {
+            for(auto& worker : workers)
+                worker.join();
+            throw;
+        }
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    bool closed = false;
+    for(size_t i = 1; i < chunks.size() && !state.empty() && !closed; ++i){
+        // A split of the real state may have closed the root element beyond the start of this
+        // chunk, what the chunks hold after it is not part of the document.
+        if(state.root_closed())
+            break;
+
+        chunk_type& chunk = chunks[i];
+        const auto where = state.where();
+        auto mark = std::lower_bound(
+            chunk.marks.begin(), chunk.marks.end(), where.document,
+            [](const typename chunk_type::mark& m, const CharT* p) { return m.where.document < p; });
+        while(mark != chunk.marks.end() && mark->where.document == where.document
+              && mark->where != where)
+            ++mark;
+
+        if(!chunk.complete || mark == chunk.marks.end() || mark->where != where){
+            // Mis-speculated, continue with the real state.
+            detail::run_sequential(state, document.data() + bounds[i + 1], tokens);
+            continue;
+        }
+
+        const size_t first = static_cast<size_t>(mark - chunk.marks.begin());
+        const int shift = static_cast<int>(state.depth())
+                          - static_cast<int>(mark->depth - detail::speculative_depth);
+        for(size_t t = first; t < chunk.tokens.size() && !closed; ++t){
+            const int depth =
+                static_cast<int>(chunk.marks[t + 1].depth - detail::speculative_depth) + shift;
+            if(chunk.tokens[t].element() == ELEMENT::ERROR){
+                // Errors end a chunk, the message is still in its state.
+                tokens.push_back(chunk.last.last_token());
+                state_type::log_error(tokens.back().value.data());
+                tokens.back().depth = depth;
+            } else {
+                tokens.push_back(chunk.tokens[t].expand(document.substr(chunk.base), depth));
+            }
+
+            if(tokens.back().element == ELEMENT::END_ELEMENT && depth == 0){
+                // The speculative depth never reaches zero, end the document here instead.
+                tokens.push_back(token_type(ELEMENT::END_DOCUMENT));
+                closed = true;
+            }
+        }
+        state = chunk.last;
+        state.set_log_errors(true);
+        state.set_depth(static_cast<size_t>(
+            static_cast<std::ptrdiff_t>(chunk.last.depth() - detail::speculative_depth) + shift));
+    }
+
+    // Up to the END_DOCUMENT or ERROR token that ends the document, after the root element or
+    // where a truncated document runs out.
+    if(!closed)
+        detail::run_sequential(state, static_cast<const CharT*>(nullptr), tokens);
+    return tokens;
+}
+
+}
+
+} // END NAMESPACE
@@ -0,0 +1,377 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "svbb/config.hpp"
+#include "svbb/split.hpp"
+#include "svbb/trim.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+enum class AXIS { CHILD, DESCENDANT };
+
+template<typename CharT, typename Traits>
+struct path_step {
+    using view_type = basic_string_view<CharT, Traits>;
+    AXIS axis = AXIS::CHILD;
+    view_type qname;       // "*" matches every element
+    view_type attribute;   // [@attribute] predicate, empty if there is none
+    view_type value;       // [@attribute="value"] predicate
+    bool has_value = false;
+
+    SVBB_CONSTEXPR bool matches(view_type name) const SVBB_NOEXCEPT
+    {
+        return (qname.size() == 1 && qname[0] == '*') || (qname == name);
+    }
+};
+
+// Compiled subset of XPath:
+//   /a/b          child steps
+//   //b           descendant steps
+//   /a/*          any element name
+//   /a[@x]        element with an attribute x
+//   /a[@x="v"]    element with an attribute x equal to v
+//   /a/@x         select the attribute x instead of the text of the element
+template<typename CharT, typename Traits>
+class path
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using step_type = path_step<CharT, Traits>;
+
+    // One bit per step plus the match bit in a 32 bit mask.
+    static constexpr size_t max_steps = 31;
+
+    SVBB_CONSTEXPR path() SVBB_NOEXCEPT : steps_(), size_(0), valid_(false) {}
+    SVBB_CXX14_CONSTEXPR explicit path(view_type expression) : steps_(), size_(0), valid_(false)
+    {
+        valid_ = compile(expression);
+    }
+
+    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return valid_; }
+    SVBB_CONSTEXPR size_t size() const SVBB_NOEXCEPT { return size_; }
+    SVBB_CONSTEXPR const step_type& operator[](size_t i) const { return steps_[i]; }
+
+    // Selected attribute, empty if the text of the matched elements is selected.
+    SVBB_CONSTEXPR view_type attribute() const SVBB_NOEXCEPT { return attribute_; }
+
+private:
+    std::array<step_type, max_steps> steps_;
+    size_t size_;
+    view_type attribute_;
+    bool valid_;
+
+    static constexpr view_type whitespace_ = " \t\r\n";
+
+    SVBB_CXX14_CONSTEXPR bool compile(view_type expression)
+    {
+        if(expression.empty() || expression[0] != '/')
+            return false;
+
+        while(!expression.empty()){
+            if(expression[0] != '/' || size_ == max_steps)
+                return false;
+            expression.remove_prefix(1);
+
+            step_type step;
+            if(!expression.empty() && expression[0] == '/'){
+                step.axis = AXIS::DESCENDANT;
+                expression.remove_prefix(1);
+            }
+
+            if(!expression.empty() && expression[0] == '@'){
+                attribute_ = expression.substr(1);
+                return (step.axis == AXIS::CHILD) && (size_ != 0) && !attribute_.empty()
+                    && attribute_.find('/') == view_type::npos;
+            }
+
+            auto name = split_at(expression, expression.find_first_of("/["));
+            step.qname = name.left;
+            expression = name.right;
+            if(step.qname.empty())
+                return false;
+
+            if(!expression.empty() && expression[0] == '['){
+                auto closing = expression.find(']');
+                if(closing == view_type::npos
+                   || !compilePredicate(step, expression.substr(1, closing - 1)))
+                    return false;
+                expression.remove_prefix(closing + 1);
+            }
+            steps_[size_++] = step;
+        }
+        return true;
+    }
+
+    static SVBB_CXX14_CONSTEXPR bool compilePredicate(step_type& step, view_type predicate)
+    {
+        predicate = trim(predicate, whitespace_);
+        if(predicate.empty() || predicate[0] != '@')
+            return false;
+
+        auto parts = split_before(predicate.substr(1), CharT('='));
+        step.attribute = trim(parts.left, whitespace_);
+        if(step.attribute.empty())
+            return false;
+        if(parts.right.empty())
+            return true;
+
+        auto value = trim(parts.right.substr(1), whitespace_);
+        if(value.size() < 2 || (value[0] != '"' && value[0] != '\'') || value.back() != value[0])
+            return false;
+        step.value = value.substr(1, value.size() - 2);
+        step.has_value = true;
+        return true;
+    }
+};
+
+namespace detail {
+
+// Runs a compiled path over the token stream. The match state of every open element is a bit
+// mask of the steps still to be matched by its children, with bit size() marking a complete
+// match. Elements whose mask is empty can't contain a match and are skipped without tokenizing.
+template<typename CharT, typename Traits, size_t MaxDepth>
+class query_state
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using path_type = path<CharT, Traits>;
+    using mask_type = std::uint32_t;
+
+    SVBB_CONSTEXPR query_state() SVBB_NOEXCEPT : path_(nullptr) {}
+    query_state(view_type document, const path_type* p)
+        : tokens_(document), path_(p), full_(mask_type(1) << p->size())
+    {
+        masks_[0] = p->valid() ? 1 : 0;
+        error_ = !p->valid();
+    }
+
+    SVBB_CONSTEXPR view_type value() const SVBB_NOEXCEPT { return value_; }
+    SVBB_CONSTEXPR view_type remainder() const SVBB_NOEXCEPT { return tokens_.remainder(); }
+    SVBB_CONSTEXPR bool error() const SVBB_NOEXCEPT { return error_; }
+
+    // Advance to the next matching value, false at the end of the document or on error.
+    bool next()
+    {
+        if(error_)
+            return false;
+
+        while(true){
+            if(attributes_){
+                while(tokens_.has_attributes()){
+                    tokens_.split();
+                    const auto token = tokens_.last_token();
+                    if(token.qname == path_->attribute()){
+                        value_ = token.value;
+                        return true;
+                    }
+                }
+                attributes_ = false;
+                if((masks_[depth_] & ~full_) == 0)
+                    skip();
+                continue;
+            }
+
+            if(tokens_.empty())
+                return false;
+            tokens_.split();
+
+            const auto token = tokens_.last_token();
+            switch(token.element){
+                case ELEMENT::START_ELEMENT:
+                    if(!enter(token.qname))
+                        return false;
+                    break;
+                case ELEMENT::END_ELEMENT:
+                    --depth_;
+                    break;
+                case ELEMENT::CHARACTERS:
+                    if(path_->attribute().empty() && (masks_[depth_] & full_)){
+                        value_ = token.value;
+                        return true;
+                    }
+                    break;
+                case ELEMENT::ERROR:
+                    error_ = true;
+                    return false;
+                default:
+                    break;
+            }
+        }
+    }
+
+private:
+    using state_type = token_state<CharT, Traits>;
+    using step_type = typename path_type::step_type;
+
+    state_type tokens_;
+    const path_type* path_;
+    std::array<mask_type, MaxDepth + 1> masks_{};
+    mask_type full_ = 0;
+    size_t depth_ = 0;
+    view_type value_;
+    bool attributes_ = false;
+    bool error_ = false;
+
+    bool enter(view_type qname)
+    {
+        mask_type next = 0;
+        mask_type pending = 0;
+        const mask_type parent = masks_[depth_];
+        for(size_t i = 0; i < path_->size(); ++i){
+            if(!(parent & (mask_type(1) << i)))
+                continue;
+            const step_type& step = (*path_)[i];
+            if(step.axis == AXIS::DESCENDANT)
+                next |= mask_type(1) << i;
+            if(step.matches(qname)){
+                if(step.attribute.empty())
+                    next |= mask_type(1) << (i + 1);
+                else
+                    pending |= mask_type(1) << i;
+            }
+        }
+
+        // Predicates are resolved on a copy, the attributes may still have to be selected.
+        if(pending){
+            auto probe = tokens_;
+            while(probe.has_attributes()){
+                probe.split();
+                const auto token = probe.last_token();
+                for(size_t i = 0; i < path_->size(); ++i){
+                    const step_type& step = (*path_)[i];
+                    if((pending & (mask_type(1) << i)) && token.qname == step.attribute
+                       && (!step.has_value || token.value == step.value))
+                        next |= mask_type(1) << (i + 1);
+                }
+            }
+        }
+
+        ++depth_;
+        if(next == 0){
+            skip();
+            return !error_;
+        }
+        if(depth_ > MaxDepth){
+            error_ = true;
+            return false;
+        }
+
+        masks_[depth_] = next;
+        if((next & full_) && !path_->attribute().empty())
+            attributes_ = true;
+        return true;
+    }
+
+    void skip()
+    {
+        tokens_.skip_subtree();
+        if(tokens_.last_token().element == ELEMENT::ERROR)
+            error_ = true;
+        --depth_;
+    }
+};
+} // namespace detail
+
+template<typename CharT, typename Traits, size_t MaxDepth>
+class query_iterator
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using value_type = view_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+    using iterator_category = std::forward_iterator_tag;
+    using state_type = detail::query_state<CharT, Traits, MaxDepth>;
+    using path_type = path<CharT, Traits>;
+
+    SVBB_CONSTEXPR query_iterator() SVBB_NOEXCEPT : done_(true) {}
+    query_iterator(view_type input, const path_type* p) : state_(input, p), done_(false)
+    {
+        advance();
+    }
+
+    SVBB_CONSTEXPR reference operator*() const SVBB_NOEXCEPT { return state_.value(); }
+    query_iterator& operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    query_iterator operator++(int)
+    {
+        query_iterator tmp = *this;
+        advance();
+        return tmp;
+    }
+
+    SVBB_CONSTEXPR bool operator==(const query_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return (!done_ && !rhs.done_) ?
+                   (state_.remainder().data() == rhs.state_.remainder().data() &&
+                    state_.value().data() == rhs.state_.value().data()) :
+                   (done_ == rhs.done_);
+    }
+    SVBB_CONSTEXPR bool operator!=(const query_iterator& rhs) const SVBB_NOEXCEPT
+    {
+        return !(*this == rhs);
+    }
+
+    // The query stopped on a malformed document, an invalid path or too deep nesting.
+    SVBB_CONSTEXPR bool error() const SVBB_NOEXCEPT { return state_.error(); }
+
+private:
+    state_type state_;
+    bool done_;
+
+    void advance() { done_ = !state_.next(); }
+};
+
+template<typename CharT, typename Traits, size_t MaxDepth = 32>
+class query_range
+{
+public:
+    using iterator = query_iterator<CharT, Traits, MaxDepth>;
+    using const_iterator = iterator;
+    using view_type = typename iterator::view_type;
+    using path_type = path<CharT, Traits>;
+
+    query_range(view_type view, path_type p) : view_(view), path_(p) {}
+
+    // Iterators refer to the path owned by the range.
+    auto begin() const -> iterator { return iterator(view_, &path_); }
+    SVBB_CONSTEXPR auto end() const SVBB_NOEXCEPT -> iterator { return iterator(); }
+
+private:
+    view_type view_;
+    path_type path_;
+};
+
+template<typename CharT, typename Traits>
+SVBB_CXX14_CONSTEXPR auto compile_path(basic_string_view<CharT, Traits> expression)
+    -> path<CharT, Traits>
+{
+    return path<CharT, Traits>(expression);
+}
+
+template<size_t MaxDepth = 32, typename CharT, typename Traits>
+auto query(basic_string_view<CharT, Traits> view, const path<CharT, Traits>& p)
+    -> query_range<CharT, Traits, MaxDepth>
+{
+    return query_range<CharT, Traits, MaxDepth>(view, p);
+}
+
+template<size_t MaxDepth = 32, typename CharT, typename Traits>
+auto query(basic_string_view<CharT, Traits> view, basic_string_view<CharT, Traits> expression)
+    -> query_range<CharT, Traits, MaxDepth>
+{
+    return query_range<CharT, Traits, MaxDepth>(view, path<CharT, Traits>(expression));
+}
+
+}
+
+} // END NAMESPACE
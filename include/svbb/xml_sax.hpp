@@ -0,0 +1,199 @@
+#pragma once
+#include <type_traits>
+
+#include "svbb/config.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+namespace sax {
+// Every callback is resolved at compile time. The int overload is picked when the handler has
+// the member, otherwise the long overload does nothing. The return type tells whether the
+// handler implements the callback.
+
+template<typename H>
+auto on_start_document(H& h, int) -> decltype(h.on_start_document(), std::true_type())
+{
+    h.on_start_document();
+    return {};
+}
+template<typename H>
+std::false_type on_start_document(H&, long) { return {}; }
+
+template<typename H>
+auto on_end_document(H& h, int) -> decltype(h.on_end_document(), std::true_type())
+{
+    h.on_end_document();
+    return {};
+}
+template<typename H>
+std::false_type on_end_document(H&, long) { return {}; }
+
+template<typename H, typename V>
+auto on_prolog(H& h, V name, V value, int) -> decltype(h.on_prolog(name, value), std::true_type())
+{
+    h.on_prolog(name, value);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_prolog(H&, V, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_start_element(H& h, V qname, int) -> decltype(h.on_start_element(qname), std::true_type())
+{
+    h.on_start_element(qname);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_start_element(H&, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_attribute(H& h, V qname, V value, int)
+    -> decltype(h.on_attribute(qname, value), std::true_type())
+{
+    h.on_attribute(qname, value);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_attribute(H&, V, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_characters(H& h, V value, int) -> decltype(h.on_characters(value), std::true_type())
+{
+    h.on_characters(value);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_characters(H&, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_end_element(H& h, V qname, int) -> decltype(h.on_end_element(qname), std::true_type())
+{
+    h.on_end_element(qname);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_end_element(H&, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_processing_instruction(H& h, V target, V data, int)
+    -> decltype(h.on_processing_instruction(target, data), std::true_type())
+{
+    h.on_processing_instruction(target, data);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_processing_instruction(H&, V, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_comment(H& h, V value, int) -> decltype(h.on_comment(value), std::true_type())
+{
+    h.on_comment(value);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_comment(H&, V, long) { return {}; }
+
+template<typename H, typename V>
+auto on_error(H& h, V message, int) -> decltype(h.on_error(message), std::true_type())
+{
+    h.on_error(message);
+    return {};
+}
+template<typename H, typename V>
+std::false_type on_error(H&, V, long) { return {}; }
+
+// True if Handler has on_attribute(qname, value) for views V.
+template<typename Handler, typename V>
+struct handles_attributes
+    : decltype(on_attribute(std::declval<Handler&>(), std::declval<V>(), std::declval<V>(), 0))
+{
+};
+
+// True if Handler has on_comment(value) for views V.
+template<typename Handler, typename V>
+struct handles_comments : decltype(on_comment(std::declval<Handler&>(), std::declval<V>(), 0))
+{
+};
+
+// True if Handler has on_prolog(name, value) or on_processing_instruction(target, data).
+template<typename Handler, typename V>
+struct handles_processing_instructions
+    : std::integral_constant<bool,
+          decltype(on_prolog(std::declval<Handler&>(), std::declval<V>(), std::declval<V>(), 0))::value
+          || decltype(on_processing_instruction(std::declval<Handler&>(), std::declval<V>(),
+                                                std::declval<V>(), 0))::value>
+{
+};
+
+// Tokenizer policy that only splits what Handler has callbacks for.
+template<typename Handler, typename V>
+struct handler_policy : default_policy
+{
+    static constexpr bool attributes = handles_attributes<Handler, V>::value;
+    static constexpr bool comments = handles_comments<Handler, V>::value;
+    static constexpr bool processing_instructions = handles_processing_instructions<Handler, V>::value;
+};
+} // namespace sax
+
+// Push parser: calls the on_... members of 'handler' for the tokens of 'document'. Handlers
+// implement any subset of
+//   on_start_document()                  on_end_document()
+//   on_prolog(name, value)               on_processing_instruction(target, data)
+//   on_start_element(qname)              on_end_element(qname)
+//   on_attribute(qname, value)           on_characters(value)
+//   on_comment(value)                    on_error(message)
+// with the views passed by value. Missing callbacks cost nothing: without on_attribute the
+// attributes aren't even split, without on_comment, on_prolog and on_processing_instruction
+// comments and PIs are skipped over (see sax::handler_policy).
+// Returns false if the document is malformed.
+template<typename CharT, typename Traits, typename Handler>
+bool parse(basic_string_view<CharT, Traits> document, Handler& handler)
+{
+    using view_type = basic_string_view<CharT, Traits>;
+
+    detail::token_state<CharT, Traits, sax::handler_policy<Handler, view_type>> state(document);
+    while(!state.empty()){
+        state.split();
+        const auto& t = state.current_token();
+        switch(t.element){
+            case ELEMENT::START_DOCUMENT:
+                sax::on_start_document(handler, 0);
+                break;
+            case ELEMENT::END_DOCUMENT:
+                sax::on_end_document(handler, 0);
+                break;
+            case ELEMENT::PROLOG:
+                sax::on_prolog(handler, t.qname, t.value, 0);
+                break;
+            case ELEMENT::START_ELEMENT:
+                sax::on_start_element(handler, t.qname, 0);
+                break;
+            case ELEMENT::ELEMENT_ATTRIBUTE:
+                sax::on_attribute(handler, t.qname, t.value, 0);
+                break;
+            case ELEMENT::CHARACTERS:
+                sax::on_characters(handler, t.value, 0);
+                break;
+            case ELEMENT::END_ELEMENT:
+                sax::on_end_element(handler, t.qname, 0);
+                break;
+            case ELEMENT::PROCESSING_INSTRUCTION:
+                sax::on_processing_instruction(handler, t.qname, t.value, 0);
+                break;
+            case ELEMENT::COMMENT:
+                sax::on_comment(handler, t.value, 0);
+                break;
+            case ELEMENT::ERROR:
+                sax::on_error(handler, t.value, 0);
+                return false;
+        }
+    }
+    return true;
+}
+
+}
+
+} // END NAMESPACE
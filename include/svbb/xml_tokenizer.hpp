@@ -1,17 +1,17 @@
 #pragma once
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 
 #include "svbb/config.hpp"
 #include "svbb/split.hpp"
 #include "svbb/trim.hpp"
 #include "svbb/literals.hpp"
+#include "svbb/utf8.hpp"
 
 namespace SVBB_NAMESPACE {
 
 namespace xml {
-// Using NILL for json special value 'null' becasue null or NULL are often
-// preprocessor definitions of (void) or (void*) which can cause
-// issues.
 enum class ELEMENT{
     PROLOG, START_DOCUMENT, START_ELEMENT, END_ELEMENT, ELEMENT_ATTRIBUTE,
     CHARACTERS, PROCESSING_INSTRUCTION, END_DOCUMENT, COMMENT, ERROR,
@@ -85,11 +85,51 @@ OSTREAM& operator<<(OSTREAM& os, const token<CharT, Traits>& obj){
 }
 
 
+// Compile time options of the tokenizer, see tokenize<Policy>(). Derive from default_policy
+// and hide the members that should differ:
+//   struct tags_only : xml::default_policy { static constexpr bool attributes = false; };
+// Switched off features are not compiled into the state machine.
+struct default_policy
+{
+    // Trim whitespace around CHARACTERS and drop whitespace only text. Otherwise the text
+    // between tags is reported as is.
+    static constexpr bool trim_text = true;
+    // Split attributes into ELEMENT_ATTRIBUTE tokens. Otherwise a tag is only looked at for
+    // its name and the '>' that ends it.
+    static constexpr bool attributes = true;
+    // Report COMMENT tokens. Otherwise comments are skipped with a search for "-->".
+    static constexpr bool comments = false;
+    // Report PROLOG and PROCESSING_INSTRUCTION tokens. Otherwise they are skipped with a
+    // search for "?>".
+    static constexpr bool processing_instructions = true;
+    // Count the open elements. Otherwise depth() stays 0 and the document ends when there is
+    // no tag left.
+    static constexpr bool track_depth = true;
+    // Validate the UTF-8 of the document while it is tokenized. An invalid sequence ends it
+    // with an ERROR token, token_state::utf8_error_offset() tells where it is.
+    static constexpr bool validate_utf8 = false;
+};
+
 namespace detail {
 
-template<typename CharT, typename Traits>
+// Stands in for utf8::validator when the policy doesn't validate.
+struct no_validation
+{
+    SVBB_CONSTEXPR bool feed(const char*, size_t) const SVBB_NOEXCEPT { return true; }
+    SVBB_CONSTEXPR bool finish() const SVBB_NOEXCEPT { return true; }
+    SVBB_CONSTEXPR size_t error_offset() const SVBB_NOEXCEPT { return utf8::validator::npos; }
+};
+
+template<typename CharT, typename Traits, typename Policy = default_policy>
 class token_state
 {
+    static_assert(!Policy::validate_utf8 || sizeof(CharT) == 1,
+                  "UTF-8 is validated on byte strings");
+
+    enum class STATE {
+        PRE, START, CHARACTERS, START_ELEMENT, EMPTY_NODE, END, ATTRIBS, ATTRIBS_EMPTY, ERROR
+    };
+
 public:
     using view_type = basic_string_view<CharT, Traits>;
     using split_type = split_result<CharT, Traits>;
@@ -102,8 +142,16 @@ public:
         : state_(STATE::PRE), document_(input), token_(ELEMENT::START_DOCUMENT)
     {
     }
+    // Resume inside a document: 'fragment' starts right after the '<' of a tag and 'depth'
+    // elements are open.
+    SVBB_CONSTEXPR token_state(view_type fragment, size_t depth)
+        : state_(STATE::START_ELEMENT), document_(fragment), token_(ELEMENT::START_DOCUMENT),
+          depth_(depth)
+    {
+    }
 
     SVBB_CONSTEXPR token_type last_token() const SVBB_NOEXCEPT { return token_; }
+    SVBB_CONSTEXPR const token_type& current_token() const SVBB_NOEXCEPT { return token_; }
     SVBB_CONSTEXPR view_type remainder() const SVBB_NOEXCEPT { return document_; }
 
     // Use 'restock' a partial document_ buffer, don't forget the remainder...
@@ -114,15 +162,213 @@ public:
             (document_.empty() &&  (state_ == STATE::PRE)));
     }
 
-    SVBB_CXX14_CONSTEXPR void split() 
-    { 
+    // Offset in the document of the invalid UTF-8 sequence that ended it, utf8::validator::npos
+    // if there is none or the policy doesn't validate.
+    SVBB_CONSTEXPR size_t utf8_error_offset() const SVBB_NOEXCEPT
+    {
+        return validator_.error_offset();
+    }
+
+    // Number of currently open elements.
+    SVBB_CONSTEXPR size_t depth() const SVBB_NOEXCEPT { return depth_; }
+    // True once the root element has been closed, the next split() ends the document.
+    SVBB_CONSTEXPR bool root_closed() const SVBB_NOEXCEPT
+    {
+        return Policy::track_depth && depth_ == 0 && state_ != STATE::PRE
+            && state_ != STATE::START && state_ != STATE::END && state_ != STATE::ERROR;
+    }
+    SVBB_CXX14_CONSTEXPR void set_depth(size_t depth) SVBB_NOEXCEPT { depth_ = depth; }
+
+    // Position of the state machine within the document. Two states over the same document
+    // that compare equal here produce the same tokens from then on (up to depth).
+    struct resume_point
+    {
+        const CharT* document;
+        const CharT* attribs;
+        STATE state;
+
+        SVBB_CONSTEXPR bool operator==(const resume_point& rhs) const SVBB_NOEXCEPT
+        {
+            return document == rhs.document && attribs == rhs.attribs && state == rhs.state;
+        }
+        SVBB_CONSTEXPR bool operator!=(const resume_point& rhs) const SVBB_NOEXCEPT
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    SVBB_CONSTEXPR resume_point where() const SVBB_NOEXCEPT
+    {
+        return {document_.data(), has_attributes() ? attribs_.data() : nullptr, state_};
+    }
+
+    // True while the attributes of the last START_ELEMENT are still to be split.
+    SVBB_CONSTEXPR bool has_attributes() const SVBB_NOEXCEPT
+    {
+        return (state_ == STATE::ATTRIBS) || (state_ == STATE::ATTRIBS_EMPTY);
+    }
+
+    // Drop the attributes of the last START_ELEMENT without splitting them.
+    SVBB_CXX14_CONSTEXPR void skip_attributes() SVBB_NOEXCEPT
+    {
+        if(state_ == STATE::ATTRIBS)
+            state_ = STATE::CHARACTERS;
+        else if(state_ == STATE::ATTRIBS_EMPTY)
+            state_ = STATE::EMPTY_NODE;
+    }
+
+    // Jump to the END_ELEMENT of the innermost open element. Its content is only scanned for
+    // tag delimiters to count depth, no tokens are built for it.
+    // Returns false if there is no open element to skip.
+    SVBB_CXX14_CONSTEXPR bool skip_subtree()
+    {
+        switch(state_){
+            case STATE::EMPTY_NODE:
+            case STATE::ATTRIBS_EMPTY:
+                return splitEmptyNode();
+            case STATE::ATTRIBS:
+            case STATE::CHARACTERS:
+            case STATE::START_ELEMENT:
+                if(depth_ != 0 || !Policy::track_depth)
+                    break;
+                return false;
+            default:
+                return false;
+        }
+
+        // START_ELEMENT means the '<' of the next tag has already been consumed.
+        const CharT* from = document_.data();
+        bool at_tag = (state_ == STATE::START_ELEMENT);
+        size_t open = 1;
+        size_t pos = 0;
+        while(true){
+            if(!at_tag){
+                pos = document_.find('<', pos);
+                if(pos == view_type::npos)
+                    break;
+                ++pos;
+            }
+            at_tag = false;
+            if(pos >= document_.size())
+                break;
+
+            const size_t closing = tag_end(pos);
+            if(closing == view_type::npos)
+                break;
+
+            if(document_[pos] == '/'){
+                if(--open == 0){
+                    if(Policy::track_depth)
+                        --depth_;
+                    token_ = {ELEMENT::END_ELEMENT, document_.substr(pos + 1, closing - pos - 1)};
+                    document_.remove_prefix(closing + 1);
+                    state_ = STATE::CHARACTERS;
+                    check_encoding(from);
+                    return true;
+                }
+            } else if(document_[pos] != '!' && document_[pos] != '?'
+                        && document_[closing - 1] != '/'){
+                ++open;
+            }
+            pos = closing + 1;
+        }
+
+        setError("Unexpected end of document in skipped element.");
+        return true;
+    }
+
+    // Move to the next START_ELEMENT named 'qname'. The tags on the way are only scanned for
+    // their delimiters and to count depth, no tokens are built for them.
+    // Returns false, with the document ended, if no such element follows.
+    SVBB_CXX14_CONSTEXPR bool skip_to_element(view_type qname)
+    {
+        while(state_ != STATE::CHARACTERS && state_ != STATE::START_ELEMENT){
+            switch(state_){
+                case STATE::ATTRIBS:
+                case STATE::ATTRIBS_EMPTY:
+                    skip_attributes();
+                    break;
+                case STATE::EMPTY_NODE:
+                    splitEmptyNode();
+                    break;
+                case STATE::PRE:
+                case STATE::START:
+                    // The root element is reached by the regular state machine.
+                    split();
+                    if(token_.element == ELEMENT::START_ELEMENT && token_.qname == qname)
+                        return true;
+                    break;
+                default:
+                    return false;
+            }
+        }
 
-        if( (depth_ == 0)  && (state_ != STATE::PRE) && (state_ != STATE::START)){
+        // START_ELEMENT means the '<' of the next tag has already been consumed.
+        const CharT* from = document_.data();
+        bool at_tag = (state_ == STATE::START_ELEMENT);
+        size_t pos = 0;
+        while(!Policy::track_depth || depth_ != 0){
+            if(!at_tag){
+                pos = document_.find('<', pos);
+                if(pos == view_type::npos)
+                    break;
+                ++pos;
+            }
+            at_tag = false;
+            if(pos >= document_.size())
+                break;
+
+            const size_t closing = tag_end(pos);
+            if(closing == view_type::npos)
+                break;
+
+            if(document_[pos] == '/'){
+                if(Policy::track_depth)
+                    --depth_;
+            } else if(document_[pos] != '!' && document_[pos] != '?'){
+                const size_t end_qname = pos + qname.size();
+                if(end_qname <= closing && 0 == document_.compare(pos, qname.size(), qname)
+                    && (document_[end_qname] == '>' || document_[end_qname] == '/'
+                        || whitespace_.find(document_[end_qname]) != view_type::npos)){
+                    document_.remove_prefix(pos);
+                    splitOpenOrEmptyNode();
+                    check_encoding(from);
+                    return state_ != STATE::ERROR;
+                }
+                if(Policy::track_depth && document_[closing - 1] != '/')
+                    ++depth_;
+            }
+            pos = closing + 1;
+        }
+
+        document_.remove_prefix(std::min(pos, document_.size()));
+        check_encoding(from);
+        if(state_ == STATE::ERROR){
+            // Invalid UTF-8 in the skipped part.
+        } else if(Policy::track_depth && depth_ != 0){
+            setError("Unexpected end of document.");
+        } else {
             state_ = STATE::END;
             token_ = {ELEMENT::END_DOCUMENT};
+            check_encoding(document_.data());
+        }
+        return false;
+    }
+
+    SVBB_CXX14_CONSTEXPR void split() 
+    { 
+
+        if(Policy::track_depth && (depth_ == 0)
+            && (state_ != STATE::PRE) && (state_ != STATE::START)){
+            if(state_ != STATE::END){
+                state_ = STATE::END;
+                token_ = {ELEMENT::END_DOCUMENT};
+                check_encoding(document_.data());
+            }
             return;
         }
 
+        const CharT* from = document_.data();
         bool have_token = false;
         while(!have_token){
             switch(state_){
@@ -146,15 +392,27 @@ public:
                     have_token = splitAttributes();
                     break;
                 default: 
-                    break;// Do nothing  (ERROR STATE or something, leave last error alone.)
+                    // Do nothing  (ERROR STATE or something, leave last error alone.)
+                    have_token = true;
+                    break;
             }
         }
+        check_encoding(from);
     }
     SVBB_CXX14_CONSTEXPR bool splitAttributes()
     {
         auto equals_pos = attribs_.find('=');
-        auto start_value = attribs_.find('"');
-        auto end_value = attribs_.find('"', start_value + 1);
+        auto start_value = attribs_.find_first_not_of(whitespace_, equals_pos + 1);
+        if(equals_pos == view_type::npos || start_value == view_type::npos
+            || (attribs_[start_value] != '"' && attribs_[start_value] != '\'')){
+            setError("Malformed attribute.");
+            return true;
+        }
+        auto end_value = attribs_.find(attribs_[start_value], start_value + 1);
+        if(end_value == view_type::npos){
+            setError("Unexpected end of attribute value.");
+            return true;
+        }
         auto qname = trim(attribs_.substr(0,equals_pos), whitespace_);
         auto value = attribs_.substr(start_value + 1, end_value - start_value - 1);
         token_ = {ELEMENT::ELEMENT_ATTRIBUTE, qname, value};
@@ -170,7 +428,18 @@ public:
     SVBB_CXX14_CONSTEXPR bool splitCharacters(){
         //assert(document_[-1] == '>')
         auto opening = document_.find('<');
-        auto value = trim(document_.substr(0,opening), whitespace_);
+        if(opening == view_type::npos){
+            if(Policy::track_depth){
+                setError("Unexpected end of document.");
+            } else {
+                state_ = STATE::END;
+                token_ = {ELEMENT::END_DOCUMENT};
+            }
+            return true;
+        }
+        auto value = document_.substr(0,opening);
+        if(Policy::trim_text)
+            value = trim(value, whitespace_);
         token_ = {ELEMENT::CHARACTERS, value};
         document_.remove_prefix(opening + 1);
         state_=STATE::START_ELEMENT;
@@ -207,19 +476,21 @@ public:
         {
             case '?' : 
                 result = splitPI();
-                if( result ){
+                if( state_ != STATE::ERROR ){
                     state_ = STATE::START;
                     document_ = trim_left(document_, " \r\n\t<"_sv);
-                    if(token_.qname == "xml")
+                    if(result && token_.qname == "xml")
                         token_.element = ELEMENT::PROLOG;
                 }
                 return result;
 
             case '!' : 
-                splitComment();
-                state_ = STATE::START;
-                document_ = trim_left(document_, " \r\n\t<"_sv);
-                return false;
+                result = splitComment();
+                if( state_ != STATE::ERROR ){
+                    state_ = STATE::START;
+                    document_ = trim_left(document_, " \r\n\t<"_sv);
+                }
+                return result;
             
             default : 
                 return splitOpenOrEmptyNode();
@@ -228,7 +499,8 @@ public:
 
     SVBB_CXX14_CONSTEXPR bool splitEmptyNode()
     {
-        --depth_;
+        if(Policy::track_depth)
+            --depth_;
         state_ = STATE::CHARACTERS;
         token_ = {ELEMENT::END_ELEMENT, empty_node_};
         return true;
@@ -236,7 +508,8 @@ public:
 
     SVBB_CXX14_CONSTEXPR bool splitCloseNode()
     {
-        --depth_;
+        if(Policy::track_depth)
+            --depth_;
         document_.remove_prefix(1);
         auto closing = document_.find('>');
         token_ = {ELEMENT::END_ELEMENT, document_.substr(0,closing)};
@@ -254,10 +527,11 @@ public:
         auto closing = document_.find_first_of('>');
         auto end_qname = document_.find_first_of(" \n\t\r>");
         auto qname = trim(document_.substr(0, end_qname), " \n\t\r/"_sv);
-        attribs_ = trim(document_.substr(end_qname, closing - end_qname), " \t\r\n/"_sv);
+        if(Policy::attributes)
+            attribs_ = trim(document_.substr(end_qname, closing - end_qname), " \t\r\n/"_sv);
         token_ = {ELEMENT::START_ELEMENT, qname};
 
-        if(attribs_.empty()){
+        if(!Policy::attributes || attribs_.empty()){
             if(document_[closing-1] == '/') {
                 state_ = STATE::EMPTY_NODE;
                 empty_node_ = qname;
@@ -274,7 +548,8 @@ public:
                 empty_node_ = view_type();
             }
         }
-        ++depth_;
+        if(Policy::track_depth)
+            ++depth_;
         document_.remove_prefix(closing + 1);
 
         return true;
@@ -284,29 +559,30 @@ public:
     {
         switch(document_[0]){
             case '/' : return splitCloseNode();
-            case '!' : splitComment(); return false;
+            case '!' : return splitComment();
             case '?' : return splitPI();
             default  : return splitOpenOrEmptyNode();
         }
     }
 
+    // Returns true if there is a token, a COMMENT or an ERROR.
     bool splitComment()
     {
-        if(0 == document_.compare(0, 3, "!--")){
-            document_.remove_prefix(3);
-            auto closing = document_.find('>',1);
-            while(  (closing != view_type::npos) 
-                    && (0 != document_.compare(closing - 2, 3, "-->"))){
-                closing = document_.find('>', ++closing);
-            }
-            token_ = {ELEMENT::COMMENT, document_.substr(0,closing-2)};
-            document_.remove_prefix(closing + 1);
-            state_ = STATE::CHARACTERS;
+        if(0 != document_.compare(0, 3, "!--")){
+            setError("Node started with illegal character.");
             return true;
         }
-        else
-            setError("Node started with illegal character.");
-        return false;
+        document_.remove_prefix(3);
+        auto closing = document_.find("-->");
+        if(closing == view_type::npos){
+            setError("Unexpected end of document in comment.");
+            return true;
+        }
+        if(Policy::comments)
+            token_ = {ELEMENT::COMMENT, document_.substr(0,closing)};
+        document_.remove_prefix(closing + 3);
+        state_ = STATE::CHARACTERS;
+        return Policy::comments;
     }
 
     bool splitPI()
@@ -315,6 +591,16 @@ public:
 
         // Processing Instruction
         document_.remove_prefix(1);
+        if(!Policy::processing_instructions){
+            auto closing = document_.find("?>");
+            if(closing == view_type::npos){
+                setError("Unexpected end of document in processing instruction.");
+                return true;
+            }
+            document_.remove_prefix(closing + 2);
+            state_ = STATE::CHARACTERS;
+            return false;
+        }
 
         // Prolog often has XML embedded within.
         // search for the ?> at the end.
@@ -324,6 +610,10 @@ public:
         {
             closing = document_.find('>', ++closing);
         }
+        if(closing == view_type::npos){
+            setError("Unexpected end of document in processing instruction.");
+            return true;
+        }
 
         auto whole_pi = trim(document_.substr(0,closing-1), whitespace_);
         auto parts = split_before(whole_pi, whitespace_);
@@ -338,15 +628,65 @@ public:
 
     void setError(const char* message)
     {
-        std::cerr << "XML Parse error: " << message << std::endl;
+        if(log_errors_)
+            log_error(message);
         token_ = {ELEMENT::ERROR, message};
         state_ = STATE::ERROR;
     }
 
+    // Whether setError() also writes the message to std::cerr, on unless turned off for a
+    // state whose errors may not be real, as a speculative one.
+    SVBB_CXX14_CONSTEXPR void set_log_errors(bool log) SVBB_NOEXCEPT { log_errors_ = log; }
+    static void log_error(const char* message)
+    {
+        std::cerr << "XML Parse error: " << message << std::endl;
+    }
+
 private:
-    enum class STATE {
-        PRE, START, CHARACTERS, START_ELEMENT, EMPTY_NODE, END, ATTRIBS, ATTRIBS_EMPTY, ERROR
-    };
+    // Validate what has been consumed since 'from', if the policy asks for it. Once the
+    // document has ended the rest of the input, which is not tokenized, is validated as well
+    // and must not end inside a sequence.
+    void check_encoding(const CharT* from)
+    {
+        if(!Policy::validate_utf8 || state_ == STATE::ERROR)
+            return;
+        bool valid = validator_.feed(reinterpret_cast<const char*>(from),
+                                     static_cast<size_t>(document_.data() - from));
+        if(valid && state_ == STATE::END){
+            valid = validator_.feed(reinterpret_cast<const char*>(document_.data()),
+                                    document_.size())
+                    && validator_.finish();
+            document_.remove_prefix(document_.size());
+        }
+        if(!valid)
+            setError("Invalid UTF-8.");
+    }
+
+    // Position of the '>' that ends the tag starting at document_[pos], right after its '<'.
+    SVBB_CXX14_CONSTEXPR size_t tag_end(size_t pos) const
+    {
+        size_t closing;
+        switch(document_[pos]){
+            case '!':
+                if(0 == document_.compare(pos, 3, "!--")){
+                    closing = document_.find("-->", pos + 3);
+                    if(closing != view_type::npos)
+                        closing += 2;
+                } else {
+                    closing = document_.find('>', pos);
+                }
+                break;
+            case '?':
+                closing = document_.find("?>", pos);
+                if(closing != view_type::npos)
+                    closing += 1;
+                break;
+            default:
+                closing = document_.find('>', pos);
+                break;
+        }
+        return closing;
+    }
 
     static constexpr view_type whitespace_ = " \t\r\n";
     //std::vector<std::string> nodes_;
@@ -357,10 +697,13 @@ private:
     view_type empty_node_;
     token_type token_;
     size_t depth_  = 0;
+    bool log_errors_ = true;
+    typename std::conditional<Policy::validate_utf8, utf8::validator, no_validation>::type
+        validator_;
 };
 } // namespace detail
 
-template<typename CharT, typename Traits>
+template<typename CharT, typename Traits, typename Policy = default_policy>
 class token_iterator
 {
 public:
@@ -370,7 +713,7 @@ public:
     using pointer = const value_type*;
     using reference = value_type;
     using iterator_category = std::forward_iterator_tag;
-    using state_type = detail::token_state<CharT, Traits>;
+    using state_type = detail::token_state<CharT, Traits, Policy>;
 
     SVBB_CONSTEXPR token_iterator() SVBB_NOEXCEPT = default;
     SVBB_CXX14_CONSTEXPR token_iterator(view_type input)
@@ -405,7 +748,19 @@ public:
         return !(*this == rhs);
     }
 
-    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return state_ != nullptr; }
+    SVBB_CONSTEXPR bool valid() const SVBB_NOEXCEPT { return !state_.empty(); }
+
+    // Jump to the END_ELEMENT of the innermost open element, the one just started when the
+    // iterator is at a START_ELEMENT. Nothing inside it is tokenized.
+    // Returns false if there is no open element.
+    SVBB_CXX14_CONSTEXPR bool skip_subtree() { return state_.skip_subtree(); }
+
+    // Move to the next START_ELEMENT named 'qname', without tokenizing anything before it.
+    // Returns false, and becomes the end iterator, if there is none.
+    SVBB_CXX14_CONSTEXPR bool skip_to_element(view_type qname)
+    {
+        return state_.skip_to_element(qname);
+    }
 
 private:
     state_type state_;
@@ -413,14 +768,15 @@ private:
     SVBB_CXX14_CONSTEXPR void advance() { state_.split(); }
 };
 
-template<typename CharT, typename Traits>
+template<typename CharT, typename Traits, typename Policy = default_policy>
 class token_range
 {
 public:
-    using iterator = token_iterator<CharT, Traits>;
+    using iterator = token_iterator<CharT, Traits, Policy>;
     using const_iterator = iterator;
     using view_type = typename iterator::view_type;
 
+    SVBB_CONSTEXPR token_range() = default;
     SVBB_CONSTEXPR token_range(view_type view)
         : begin_(view)
     {
@@ -433,13 +789,27 @@ private:
     iterator begin_;
 };
 
-template<typename CharT, typename Traits>
+// Tokens of 'view', tokenize<Policy>(view) selects the features of the tokenizer (see
+// default_policy).
+template<typename Policy = default_policy, typename CharT, typename Traits>
 SVBB_CXX14_CONSTEXPR auto tokenize(basic_string_view<CharT, Traits> view)
-    -> token_range<CharT, Traits>
+    -> token_range<CharT, Traits, Policy>
 {
-    return token_range<CharT, Traits>(view);
+    return token_range<CharT, Traits, Policy>(view);
 }
 
 }
 
-} // END NAMESPACE
\ No newline at end of file
+} // END NAMESPACE
+
+#if defined(__cpp_lib_ranges)
+namespace std::ranges {
+// Iterators own the tokenizer state, they don't refer to the range.
+template<typename CharT, typename Traits, typename Policy>
+inline constexpr bool
+    enable_borrowed_range<SVBB_NAMESPACE::xml::token_range<CharT, Traits, Policy>> = true;
+template<typename CharT, typename Traits, typename Policy>
+inline constexpr bool
+    enable_view<SVBB_NAMESPACE::xml::token_range<CharT, Traits, Policy>> = true;
+} // namespace std::ranges
+#endif
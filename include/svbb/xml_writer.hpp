@@ -0,0 +1,299 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "svbb/config.hpp"
+#include "svbb/simd.hpp"
+#include "svbb/xml_tokenizer.hpp"
+
+namespace SVBB_NAMESPACE {
+
+namespace xml {
+
+namespace detail {
+// Index of the first character of 'text' that has to be escaped, or text.size().
+template<typename CharT, typename Traits>
+size_t find_escape(basic_string_view<CharT, Traits> text, bool attribute)
+{
+    static const char special[] = "<>&\"";
+    const size_t count = attribute ? 4 : 3;
+    if(sizeof(CharT) == 1)
+        return simd::find_first_of(reinterpret_cast<const char*>(text.data()), text.size(),
+                                   special, count);
+    for(size_t i = 0; i < text.size(); ++i){
+        for(size_t k = 0; k < count; ++k){
+            if(Traits::eq(text[i], CharT(special[k])))
+                return i;
+        }
+    }
+    return text.size();
+}
+} // namespace detail
+
+// Serializes XML without copying what it is given. The output is a list of segments: views
+// passed in are kept as they are, only markup and escaped text are copied to a buffer owned by
+// the writer. Views must outlive the output. Neighbouring segments are merged, so
+// re-emitting a tokenized document mostly alternates between views into it and short runs
+// of markup.
+//
+// Text passed to start_element() ... end_element() is escaped when needed. write(token)
+// expects tokens of a tokenized document, which are already escaped, and copies them as
+// they are.
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+class writer
+{
+public:
+    using view_type = basic_string_view<CharT, Traits>;
+    using token_type = token<CharT, Traits>;
+
+    void start_element(view_type qname)
+    {
+        close_start_tag();
+        markup("<");
+        view(qname);
+        open_tag_ = true;
+    }
+    // Must directly follow start_element() or another attribute.
+    void attribute(view_type qname, view_type value) { attribute(qname, value, true); }
+    void characters(view_type text)
+    {
+        close_start_tag();
+        escaped(text, false);
+    }
+    // An element without content is written as an empty element tag.
+    void end_element(view_type qname)
+    {
+        if(open_tag_){
+            markup("/>");
+            open_tag_ = false;
+            return;
+        }
+        markup("</");
+        view(qname);
+        markup(">");
+    }
+    void comment(view_type text)
+    {
+        close_start_tag();
+        markup("<!--");
+        view(text);
+        markup("-->");
+    }
+    void processing_instruction(view_type target, view_type data)
+    {
+        close_start_tag();
+        markup("<?");
+        view(target);
+        if(!data.empty()){
+            markup(" ");
+            view(data);
+        }
+        markup("?>");
+    }
+    // Copied to the output as it is.
+    void raw(view_type text)
+    {
+        close_start_tag();
+        view(text);
+    }
+
+    void write(const token_type& t)
+    {
+        switch(t.element){
+            case ELEMENT::PROLOG: // [[fallthrough]]
+            case ELEMENT::PROCESSING_INSTRUCTION: processing_instruction(t.qname, t.value); break;
+            case ELEMENT::START_ELEMENT: start_element(t.qname); break;
+            case ELEMENT::ELEMENT_ATTRIBUTE: attribute(t.qname, t.value, false); break;
+            case ELEMENT::CHARACTERS: raw(t.value); break;
+            case ELEMENT::END_ELEMENT: end_element(t.qname); break;
+            case ELEMENT::COMMENT: comment(t.value); break;
+            default: break; // START_DOCUMENT, END_DOCUMENT and ERROR write nothing.
+        }
+    }
+
+    // Forget the output but keep the memory, for writing the next document.
+    void clear()
+    {
+        segments_.clear();
+        buffer_.clear();
+        size_ = 0;
+        open_tag_ = false;
+    }
+
+    // Characters of output so far.
+    size_t size() const SVBB_NOEXCEPT { return size_; }
+    size_t segment_count() const SVBB_NOEXCEPT { return segments_.size(); }
+    view_type segment(size_t i) const
+    {
+        const auto& s = segments_[i];
+        return {s.data ? s.data : buffer_.data() + s.offset, s.size};
+    }
+
+    // Fill up to 'count' entries of an iovec array (anything with iov_base and iov_len) with
+    // the segments from 'first' on, for writev(). Returns the number of entries filled.
+    template<typename IOVec>
+    size_t fill_iovec(IOVec* iov, size_t count, size_t first = 0) const
+    {
+        size_t n = 0;
+        for(; n < count && first + n < segments_.size(); ++n){
+            const view_type s = segment(first + n);
+            iov[n].iov_base = const_cast<CharT*>(s.data());
+            iov[n].iov_len = s.size() * sizeof(CharT);
+        }
+        return n;
+    }
+
+    // Append the output to a contiguous buffer such as std::string or std::vector<CharT>.
+    template<typename Buffer>
+    void append_to(Buffer& out) const
+    {
+        out.reserve(out.size() + size_);
+        for(size_t i = 0; i < segments_.size(); ++i){
+            const view_type s = segment(i);
+            out.insert(out.end(), s.data(), s.data() + s.size());
+        }
+    }
+
+    std::basic_string<CharT, Traits> str() const
+    {
+        std::basic_string<CharT, Traits> out;
+        append_to(out);
+        return out;
+    }
+
+private:
+    // A view, or a range of buffer_ when data is nullptr. buffer_ may move while writing.
+    struct segment_type
+    {
+        const CharT* data;
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<segment_type> segments_;
+    std::basic_string<CharT, Traits> buffer_;
+    size_t size_ = 0;
+    bool open_tag_ = false;
+
+    // A value that is not escaped here is the raw text of a token, which may have been quoted
+    // with ' and hold a ". It is quoted with ' then, unless it holds both kinds of quote, which
+    // a well-formed document never does: then its " are escaped.
+    void attribute(view_type qname, view_type value, bool escape)
+    {
+        SVBB_ASSERT(open_tag_);
+        markup(" ");
+        view(qname);
+        const bool has_quote = !escape && value.find(CharT('"')) != value.npos;
+        const bool single = has_quote && value.find(CharT('\'')) == value.npos;
+        if(single)
+            markup("='");
+        else
+            markup("=\"");
+        if(escape)
+            escaped(value, true);
+        else if(has_quote && !single)
+            escaped_quotes(value);
+        else
+            view(value);
+        if(single)
+            markup("'");
+        else
+            markup("\"");
+    }
+
+    void close_start_tag()
+    {
+        if(open_tag_){
+            markup(">");
+            open_tag_ = false;
+        }
+    }
+
+    void view(view_type v)
+    {
+        if(v.empty())
+            return;
+        size_ += v.size();
+        if(!segments_.empty()){
+            auto& last = segments_.back();
+            if(last.data && last.data + last.size == v.data()){
+                last.size += v.size();
+                return;
+            }
+        }
+        segments_.push_back({v.data(), 0, v.size()});
+    }
+
+    template<size_t N>
+    void markup(const char (&text)[N])
+    {
+        const size_t offset = buffer_.size();
+        append(text);
+        owned(offset);
+    }
+
+    // Record buffer_ from 'offset' on as output.
+    void owned(size_t offset)
+    {
+        const size_t size = buffer_.size() - offset;
+        if(size == 0)
+            return;
+        size_ += size;
+        if(!segments_.empty()){
+            auto& last = segments_.back();
+            if(!last.data && last.offset + last.size == offset){
+                last.size += size;
+                return;
+            }
+        }
+        segments_.push_back({nullptr, offset, size});
+    }
+
+    void escaped(view_type text, bool attribute)
+    {
+        size_t special = detail::find_escape(text, attribute);
+        if(special == text.size()){
+            view(text);
+            return;
+        }
+
+        const size_t offset = buffer_.size();
+        while(special != text.size()){
+            buffer_.append(text.data(), special);
+            switch(static_cast<char>(text[special])){
+                case '<': append("&lt;"); break;
+                case '>': append("&gt;"); break;
+                case '&': append("&amp;"); break;
+                default: append("&quot;"); break;
+            }
+            text.remove_prefix(special + 1);
+            special = detail::find_escape(text, attribute);
+        }
+        buffer_.append(text.data(), text.size());
+        owned(offset);
+    }
+
+    void escaped_quotes(view_type text)
+    {
+        const size_t offset = buffer_.size();
+        for(size_t quote = text.find(CharT('"')); quote != text.npos;
+            quote = text.find(CharT('"'))){
+            buffer_.append(text.data(), quote);
+            append("&quot;");
+            text.remove_prefix(quote + 1);
+        }
+        buffer_.append(text.data(), text.size());
+        owned(offset);
+    }
+
+    template<size_t N>
+    void append(const char (&text)[N])
+    {
+        for(size_t i = 0; i + 1 < N; ++i)
+            buffer_.push_back(CharT(text[i]));
+    }
+};
+
+}
+
+} // END NAMESPACE
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/adaptors.hpp"
+#include "svbb/util.hpp"
+#include "svbb/literals.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+template<typename Rng>
+std::vector<std::string> collect(const Rng& rng)
+{
+    std::vector<std::string> result;
+    for(auto token : rng)
+        result.push_back(std::string(token));
+    return result;
+}
+
+TEST_CASE("adaptors trimmed")
+{
+    using Catch::Matchers::Equals;
+    REQUIRE_THAT(collect(tokenize(" a , b,,\tc "_sv, ',') | trimmed(" \t"_sv)),
+                 Equals(std::vector<std::string>{"a", "b", "", "c"}));
+    REQUIRE_THAT(collect(tokenize("xax,bx"_sv, ',') | trimmed('x')),
+                 Equals(std::vector<std::string>{"a", "b"}));
+    REQUIRE_THAT(collect(tokenize(" a ; b "_sv, ';') | trimmed(char_set(" "))),
+                 Equals(std::vector<std::string>{"a", "b"}));
+}
+
+TEST_CASE("adaptors non_empty")
+{
+    using Catch::Matchers::Equals;
+    REQUIRE_THAT(collect(tokenize(",,a,,b,"_sv, ',') | non_empty),
+                 Equals(std::vector<std::string>{"a", "b"}));
+    REQUIRE_THAT(collect(tokenize(",,,"_sv, ',') | non_empty), Equals(std::vector<std::string>{}));
+    REQUIRE_THAT(collect(tokenize(" a, ,b "_sv, ',') | trimmed(' ') | non_empty),
+                 Equals(std::vector<std::string>{"a", "b"}));
+    // Blank tokens are only empty after trimming.
+    REQUIRE_THAT(collect(tokenize(" a, ,b "_sv, ',') | non_empty | trimmed(' ')),
+                 Equals(std::vector<std::string>{"a", "", "b"}));
+}
+
+TEST_CASE("adaptors take")
+{
+    using Catch::Matchers::Equals;
+    const auto rng = tokenize("a,b,c,d"_sv, ',') | take(2);
+    REQUIRE_THAT(collect(rng), Equals(std::vector<std::string>{"a", "b"}));
+    // Every begin() starts counting again.
+    REQUIRE_THAT(collect(rng), Equals(std::vector<std::string>{"a", "b"}));
+    REQUIRE_THAT(collect(tokenize("a,b"_sv, ',') | take(5)),
+                 Equals(std::vector<std::string>{"a", "b"}));
+    REQUIRE_THAT(collect(tokenize("a,b"_sv, ',') | take(0)), Equals(std::vector<std::string>{}));
+    REQUIRE_THAT(collect(tokenize(",,a, ,b,c"_sv, ',') | trimmed(' ') | non_empty | take(2)),
+                 Equals(std::vector<std::string>{"a", "b"}));
+}
+
+TEST_CASE("adaptors transform")
+{
+    using Catch::Matchers::Equals;
+    auto sizes = tokenize(" a , bcd,,ef"_sv, ',') | trimmed(' ') | non_empty |
+                 transform([](string_view token){ return token.size(); });
+    std::vector<size_t> result(sizes.begin(), sizes.end());
+    REQUIRE_THAT(result, Equals(std::vector<size_t>{1, 3, 2}));
+
+    auto upper = tokenize("ab,c"_sv, ',') | transform([](string_view token){
+        std::string s(token);
+        for(auto& c : s)
+            c = static_cast<char>(c - 'a' + 'A');
+        return s;
+    });
+    REQUIRE_THAT(std::vector<std::string>(upper.begin(), upper.end()),
+                 Equals(std::vector<std::string>{"AB", "C"}));
+}
+
+}
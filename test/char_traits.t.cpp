@@ -0,0 +1,80 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/char_traits.hpp"
+#include "svbb/literals.hpp"
+#include "svbb/split.hpp"
+#include "svbb/tokenize.hpp"
+#include "svbb/trim.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+static_assert("Content-Length"_svi == "content-length"_svi, "");
+static_assert("Content-Length"_svi.find('l') == 8, "");
+static_assert("abc"_svi < "ABD"_svi, "");
+static_assert("abc"_svi.compare("AB"_svi) > 0, "");
+static_assert("[\\]"_svi != "{|}"_svi, "only letters are folded");
+
+TEST_CASE("ci_char_traits compare")
+{
+    REQUIRE(ci_string_view("Host") == ci_string_view("hOST"));
+    REQUIRE(ci_string_view("Host") != ci_string_view("Hosts"));
+    REQUIRE(ci_string_view("@") != ci_string_view("`"));
+    REQUIRE(ci_string_view("Zeta").compare(ci_string_view("alpha")) > 0);
+    REQUIRE(ci_string_view("\xc3\x89") != ci_string_view("\xc3\xa9"));
+}
+
+TEST_CASE("ci_char_traits compare across blocks")
+{
+    // Every length and mismatch position around the 8 and 16 byte blocks.
+    for(size_t length = 0; length < 40; ++length){
+        std::string lower, upper;
+        for(size_t i = 0; i < length; ++i){
+            lower += static_cast<char>('a' + i % 26);
+            upper += static_cast<char>('A' + i % 26);
+        }
+        REQUIRE(ci_string_view(lower.data(), length) == ci_string_view(upper.data(), length));
+        for(size_t pos = 0; pos < length; ++pos){
+            std::string other = upper;
+            other[pos] = '~';
+            const ci_string_view a(lower.data(), length), b(other.data(), length);
+            REQUIRE(a != b);
+            REQUIRE(a.compare(b) < 0);
+            REQUIRE(b.compare(a) > 0);
+        }
+    }
+}
+
+TEST_CASE("ci_char_traits find")
+{
+    for(size_t length = 1; length < 40; ++length){
+        for(size_t pos = 0; pos < length; ++pos){
+            std::string text(length, 'x');
+            text[pos] = 'Q';
+            const ci_string_view view(text.data(), text.size());
+            REQUIRE(view.find('q') == pos);
+            REQUIRE(view.find('Q') == pos);
+        }
+    }
+    REQUIRE(ci_string_view("Keep-Alive").find("ALIVE") == 5);
+    REQUIRE(ci_string_view("Keep-Alive").find('[') == ci_string_view::npos);
+}
+
+TEST_CASE("ci_string_view with the tokenizers")
+{
+    std::vector<std::string> tokens;
+    for(auto token : tokenize("gzipXdeflatexbr"_svi, 'x'))
+        tokens.emplace_back(token.data(), token.size());
+    REQUIRE(tokens == std::vector<std::string>{"gzip", "deflate", "br"});
+
+    const auto split = split_before("boundaryXvalue"_svi, 'x');
+    REQUIRE(split.left == "BOUNDARY"_svi);
+    REQUIRE(split.right == "xVALUE"_svi);
+
+    REQUIRE(trim("aAbBcAa"_svi, 'a') == "bBc"_svi);
+}
+
+}
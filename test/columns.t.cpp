@@ -0,0 +1,58 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/columns.hpp"
+#include "svbb/util.hpp"
+#include "svbb/literals.hpp"
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+TEST_CASE("columns typed schema")
+{
+    using Catch::Matchers::Equals;
+    const auto csv = "apple,3,0.5\r\npear,10,1.25\n\nplum,-2,2\n"_sv;
+    auto batch = load_columns<text_field, std::int64_t, double>(csv, ',');
+    REQUIRE(batch.rows() == 3);
+    REQUIRE(batch.text<0>(0) == "apple"_sv);
+    REQUIRE(batch.text<0>(2) == "plum"_sv);
+    REQUIRE(batch.column<0>().offsets[1] == csv.find("pear"));
+    REQUIRE(batch.column<0>().sizes[1] == 4);
+    REQUIRE_THAT(batch.column<1>(), Equals(std::vector<std::int64_t>{3, 10, -2}));
+    REQUIRE_THAT(batch.column<2>(), Equals(std::vector<double>{0.5, 1.25, 2}));
+    const auto& counts = batch.column<1>();
+    REQUIRE(std::accumulate(counts.begin(), counts.end(), std::int64_t(0)) == 11);
+}
+
+TEST_CASE("columns preallocated")
+{
+    std::string csv;
+    for(int i = 0; i < 1000; ++i)
+        csv += std::to_string(i) + "|" + std::to_string(i * 2) + "\n";
+    auto batch = load_columns<int, int>(string_view(csv), '|');
+    REQUIRE(batch.rows() == 1000);
+    REQUIRE(batch.column<1>()[999] == 1998);
+    // Reserved from the newline count, the data never moved.
+    REQUIRE(batch.column<0>().capacity() == 1001);
+}
+
+TEST_CASE("columns bad rows")
+{
+    using Catch::Matchers::Equals;
+    const auto tsv = "a\t1\nb\tx\nc\nd\t2\te\nf\t3"_sv;
+    parse_status status;
+    auto batch = load_columns<text_field, int>(tsv, '\t', '\n', &status);
+    REQUIRE(batch.rows() == 2);
+    REQUIRE(batch.text<0>(0) == "a"_sv);
+    REQUIRE(batch.text<0>(1) == "f"_sv);
+    REQUIRE_THAT(batch.column<1>(), Equals(std::vector<int>{1, 3}));
+    REQUIRE(status.error == std::errc::invalid_argument);
+    REQUIRE(status.offset == tsv.find("b\t"));
+    REQUIRE(status.skipped == 3);
+}
+
+}
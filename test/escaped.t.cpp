@@ -0,0 +1,79 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/escaped.hpp"
+#include "svbb/literals.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+template<typename View>
+std::vector<std::string> fields(View input, char delimeter)
+{
+    std::vector<std::string> result;
+    for(auto field : tokenize_escaped(input, delimeter))
+        result.emplace_back(field.data(), field.size());
+    return result;
+}
+
+// Constant expressions take the scalar loop.
+SVBB_CXX14_CONSTEXPR size_t first_field_size(
+    basic_string_view<char, constexpr_char_traits<char>> input)
+{
+    return split_by_char_escaped<char>(',')(input).left.size();
+}
+static_assert(first_field_size(R"(a\,b,c)"_svc) == 4, "");
+static_assert(first_field_size(R"(a\\,b)"_svc) == 3, "");
+
+TEST_CASE("split_by_char_escaped skips escaped delimiters")
+{
+    REQUIRE(fields(R"(a,b\,c,d)"_sv, ',') == (std::vector<std::string>{"a", R"(b\,c)", "d"}));
+    // An even number of escapes escape each other.
+    REQUIRE(fields(R"(a\\,b\\\,c)"_sv, ',') == (std::vector<std::string>{R"(a\\)", R"(b\\\,c)"}));
+    REQUIRE(fields("x\\\ty\tz"_sv, '\t') == (std::vector<std::string>{"x\\\ty", "z"}));
+    REQUIRE(fields(R"(a,\)"_sv, ',') == (std::vector<std::string>{"a", "\\"}));
+    REQUIRE(fields(""_sv, ',').empty());
+}
+
+TEST_CASE("split_by_char_escaped against a scalar scan")
+{
+    // Runs of escapes of every length ending at every position around the 64 byte blocks,
+    // with one unescaped delimiter at the end.
+    for(size_t run = 0; run < 5; ++run){
+        for(size_t end = run; end < 140; ++end){
+            std::string text(150, 'x');
+            for(size_t i = end - run; i < end; ++i)
+                text[i] = '\\';
+            text[end] = ',';
+            text[145] = ',';
+            const size_t expected = (run % 2) ? 145 : end;
+            const auto split = split_by_char_escaped<char>(',')(string_view(text));
+            REQUIRE(split.left.size() == expected);
+        }
+    }
+}
+
+TEST_CASE("split_by_char_escaped unescape")
+{
+    const split_by_char_escaped<char> splitter(',');
+    std::string buffer;
+    const string_view plain = "plain"_sv;
+    REQUIRE(splitter.unescape(plain, buffer).data() == plain.data());
+    REQUIRE(buffer.empty());
+    REQUIRE(splitter.unescape(R"(b\,c)"_sv, buffer) == "b,c"_sv);
+    REQUIRE(splitter.unescape(R"(\\a\,\,)"_sv, buffer) == R"(\a,,)"_sv);
+    REQUIRE(splitter.unescape(R"(end\)"_sv, buffer) == R"(end\)"_sv);
+    REQUIRE(splitter.unescape("\\"_sv, buffer) == "\\"_sv);
+}
+
+
+TEST_CASE("split_by_char_escaped compares with the traits")
+{
+    std::vector<std::string> tokens;
+    for(auto t : tokenize_escaped("xAy\\ab,b"_svi, 'a'))
+        tokens.emplace_back(t.data(), t.size());
+    REQUIRE(tokens == std::vector<std::string>{"x", "y\\ab,b"});
+}
+}
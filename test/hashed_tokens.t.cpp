@@ -0,0 +1,60 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/hashed_tokens.hpp"
+#include "svbb/intern.hpp"
+#include "svbb/util.hpp"
+#include "svbb/literals.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+TEST_CASE("tokenize_hashed matches tokenize and hash_bytes")
+{
+    std::string input;
+    for(int i = 0; i < 200; ++i)
+        input += std::string(static_cast<size_t>(i % 23), static_cast<char>('a' + i % 26)) + ",";
+    input += "last";
+    for(size_t start = 0; start < 9; ++start){
+        const auto view = string_view(input).substr(start);
+        std::vector<string_view> expected(tokenize(view, ',').begin(), tokenize(view, ',').end());
+        std::vector<string_view> tokens;
+        for(auto t : tokenize_hashed(view, ',')){
+            tokens.push_back(t.token);
+            REQUIRE(t.hash == hash_bytes(t.token));
+        }
+        REQUIRE(tokens == expected);
+    }
+    for(auto t : tokenize_hashed("ab,cdefghijkl,"_sv, ',', 7))
+        REQUIRE(t.hash == hash_bytes(t.token, 7));
+    REQUIRE(tokenize_hashed(""_sv, ',').begin() == tokenize_hashed(""_sv, ',').end());
+}
+
+TEST_CASE("tokenize_hashed group by")
+{
+    intern_pool<char> pool;
+    std::vector<int> counts;
+    for(auto t : tokenize_hashed("red green red blue green red"_sv, ' ')){
+        const auto id = pool.intern(t.token, t.hash);
+        if(id == counts.size())
+            counts.push_back(0);
+        ++counts[id];
+    }
+    REQUIRE(counts == std::vector<int>{3, 2, 1});
+    REQUIRE(pool.find("green"_sv) == 1);
+}
+
+
+TEST_CASE("tokenize_hashed compares with the traits")
+{
+    const auto line = "first-field:X-SECOND-FIELD-xyz"_svi;
+    std::vector<std::string> tokens;
+    for(auto t : tokenize_hashed(line, 'x')){
+        tokens.emplace_back(t.token.data(), t.token.size());
+        REQUIRE(t.hash == hash_bytes(t.token));
+    }
+    REQUIRE(tokens == std::vector<std::string>{"first-field:", "-SECOND-FIELD-", "yz"});
+}
+}
@@ -0,0 +1,104 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/http.hpp"
+#include "svbb/literals.hpp"
+#include "svbb/util.hpp"
+#include <string>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+// Recorded from a browser, with the cookie shortened.
+const char* browser_request =
+    "GET /search?q=string+view&lang=en HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:109.0) Gecko/20100101 Firefox/115.0\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Connection: keep-alive\r\n"
+    "Cookie: session=4f2a9c; theme=dark\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "\r\n";
+
+TEST_CASE("http recorded request")
+{
+    const auto input = make_view(browser_request);
+    const auto req = http::parse_headers(input);
+    REQUIRE(req.status == http::STATUS::COMPLETE);
+    REQUIRE(req.method == "GET"_sv);
+    REQUIRE(req.target == "/search?q=string+view&lang=en"_sv);
+    REQUIRE(req.version == "HTTP/1.1"_sv);
+    REQUIRE(req.header_size == input.size());
+    REQUIRE(req.headers.size() == 8);
+    REQUIRE(req.headers[0].key == "Host"_sv);
+    REQUIRE(req.headers[0].value == "www.example.com"_sv);
+    REQUIRE(req.header("host"_sv) == "www.example.com"_sv);
+    REQUIRE(req.header("ACCEPT-ENCODING"_sv) == "gzip, deflate, br"_sv);
+    REQUIRE(req.header("cookie"_sv) == "session=4f2a9c; theme=dark"_sv);
+    REQUIRE(req.has_header("Upgrade-Insecure-Requests"_sv));
+    REQUIRE_FALSE(req.has_header("Content-Length"_sv));
+    REQUIRE(req.header("Content-Length"_sv, "0"_sv) == "0"_sv);
+}
+
+TEST_CASE("http body and bare line feeds")
+{
+    const auto input = "POST /api HTTP/1.0\nContent-Length:5\nX-Empty:\n\nhello"_sv;
+    const auto req = http::parse_headers(input);
+    REQUIRE(req.status == http::STATUS::COMPLETE);
+    REQUIRE(req.method == "POST"_sv);
+    REQUIRE(req.version == "HTTP/1.0"_sv);
+    REQUIRE(req.header("content-length"_sv) == "5"_sv);
+    REQUIRE(req.has_header("x-empty"_sv));
+    REQUIRE(req.header("x-empty"_sv).empty());
+    REQUIRE(input.substr(req.header_size) == "hello"_sv);
+}
+
+TEST_CASE("http value whitespace and colons")
+{
+    const auto req = http::parse_headers(
+        "GET / HTTP/1.1\r\nHost: \t example.com:8080 \t\r\nX-A:b:c\r\n\r\n"_sv);
+    REQUIRE(req.status == http::STATUS::COMPLETE);
+    REQUIRE(req.header("Host"_sv) == "example.com:8080"_sv);
+    REQUIRE(req.header("x-a"_sv) == "b:c"_sv);
+}
+
+TEST_CASE("http incomplete")
+{
+    const std::string full = browser_request;
+    for(size_t size = 0; size + 1 < full.size(); ++size){
+        const auto req = http::parse_headers(string_view(full.data(), size));
+        REQUIRE(req.status == http::STATUS::INCOMPLETE);
+    }
+}
+
+TEST_CASE("http invalid")
+{
+    REQUIRE(http::parse_headers("GET /\r\n\r\n"_sv).status == http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET  / HTTP/1.1\r\n\r\n"_sv).status == http::STATUS::INVALID);
+    REQUIRE(http::parse_headers(" / HTTP/1.1\r\n\r\n"_sv).status == http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET / FTP/1.1\r\n\r\n"_sv).status == http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET / HTTP/1.1\r\nHost : a\r\n\r\n"_sv).status ==
+            http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET / HTTP/1.1\r\nHost: a\r\n folded\r\n\r\n"_sv).status ==
+            http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET / HTTP/1.1\r\nno colon\r\n\r\n"_sv).status ==
+            http::STATUS::INVALID);
+    REQUIRE(http::parse_headers("GET / HTTP/1.1\r\n: a\r\n\r\n"_sv).status ==
+            http::STATUS::INVALID);
+}
+
+TEST_CASE("http many headers")
+{
+    std::string input = "GET / HTTP/1.1\r\n";
+    for(int i = 0; i < 50; ++i)
+        input += "X-Header-" + std::to_string(i) + ": " + std::to_string(i) + "\r\n";
+    input += "\r\n";
+    const auto req = http::parse_headers(string_view(input));
+    REQUIRE(req.status == http::STATUS::COMPLETE);
+    REQUIRE(req.headers.size() == 50);
+    REQUIRE(req.header("x-header-49"_sv) == "49"_sv);
+}
+
+}
@@ -0,0 +1,72 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/intern.hpp"
+#include "svbb/tokenize.hpp"
+#include "svbb/util.hpp"
+#include "svbb/literals.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+TEST_CASE("hash_bytes")
+{
+    const std::string text = "the quick brown fox jumps over the lazy dog";
+    for(size_t size = 0; size <= text.size(); ++size){
+        // Same bytes at a different address.
+        const std::string copy = text.substr(0, size);
+        REQUIRE(hash_bytes(string_view(text).substr(0, size)) == hash_bytes(string_view(copy)));
+    }
+    REQUIRE(hash_bytes(""_sv) != hash_bytes("\0"_sv.substr(0, 1)));
+    REQUIRE(hash_bytes("abcdefgh"_sv) != hash_bytes("abcdefgh\0"_sv.substr(0, 9)));
+    REQUIRE(hash_bytes("a"_sv) != hash_bytes("b"_sv));
+    REQUIRE(hash_bytes("a"_sv) != hash_bytes("a"_sv, 1));
+}
+
+TEST_CASE("intern_pool ids and views")
+{
+    intern_pool<char> pool;
+    REQUIRE(pool.empty());
+    REQUIRE(pool.find("a"_sv) == pool.npos);
+
+    std::string buffer = "GET POST GET PUT POST";
+    std::vector<intern_pool<char>::id_type> ids;
+    for(auto token : tokenize(string_view(buffer), ' '))
+        ids.push_back(pool.intern(token));
+    REQUIRE(ids == std::vector<intern_pool<char>::id_type>{0, 1, 0, 2, 1});
+    REQUIRE(pool.size() == 3);
+
+    // The pool keeps its own copies, the source buffer can go.
+    const string_view post = pool[1];
+    buffer.assign(buffer.size(), 'x');
+    REQUIRE(post == "POST"_sv);
+    REQUIRE(pool[0] == "GET"_sv);
+    REQUIRE(pool.find("PUT"_sv) == 2);
+    REQUIRE(pool.find("DELETE"_sv) == pool.npos);
+    REQUIRE(pool.intern(""_sv) == 3);
+    REQUIRE(pool.intern(""_sv) == 3);
+}
+
+TEST_CASE("intern_pool growth")
+{
+    intern_pool<char> pool(64);
+    std::vector<string_view> views;
+    for(int i = 0; i < 5000; ++i)
+        views.push_back(pool[pool.intern(string_view("token" + std::to_string(i)))]);
+    const std::string long_token(1000, 'l');
+    const auto long_id = pool.intern(string_view(long_token));
+    REQUIRE(pool.size() == 5001);
+    for(int i = 0; i < 5000; ++i){
+        const std::string token = "token" + std::to_string(i);
+        REQUIRE(pool.intern(string_view(token)) == static_cast<unsigned>(i));
+        // Views stay where they were while the pool grew.
+        REQUIRE(views[i].data() == pool[i].data());
+        REQUIRE(views[i] == string_view(token));
+    }
+    REQUIRE(pool[long_id] == string_view(long_token));
+    REQUIRE(pool.size() == 5001);
+}
+
+}
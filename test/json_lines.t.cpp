@@ -0,0 +1,88 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/json_lines.hpp"
+#include "svbb/json_tokenizer.hpp"
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+
+std::string make_lines(size_t count)
+{
+    std::string out;
+    for(size_t i = 0; i < count; ++i){
+        out += "{\"id\": " + std::to_string(i) + ", \"name\": \"record\"}";
+        out += (i % 10 == 3) ? "\r\n\n" : "\n";
+    }
+    return out;
+}
+
+// The id of a record, with the JSON tokenizer.
+size_t record_id(string_view record)
+{
+    for(auto t : json::tokenize(record)){
+        if(t.key == "id")
+            return std::stoul(std::string(t.value));
+    }
+    return static_cast<size_t>(-1);
+}
+
+TEST_CASE("JSON lines unordered")
+{
+    const std::string input = make_lines(5000);
+    std::atomic<size_t> count(0);
+    std::atomic<size_t> sum(0);
+    json::for_each_line(string_view(input), [&](string_view record){
+        ++count;
+        sum += record_id(record);
+    }, 4, 1000);
+    REQUIRE(count == 5000);
+    REQUIRE(sum == 5000 * 4999 / 2);
+}
+
+TEST_CASE("JSON lines ordered")
+{
+    const std::string input = make_lines(5000) + "{\"id\": 5000}";
+    std::vector<size_t> ids;
+    json::for_each_line_ordered(string_view(input), record_id,
+                                [&](size_t id){ ids.push_back(id); }, 4, 1000);
+    REQUIRE(ids.size() == 5001);
+    for(size_t i = 0; i < ids.size(); ++i)
+        REQUIRE(ids[i] == i);
+}
+
+TEST_CASE("JSON lines from a stream")
+{
+    const std::string input = make_lines(3000);
+    std::istringstream unordered_in(input);
+    std::atomic<size_t> count(0);
+    json::for_each_line(unordered_in, [&](string_view){ ++count; }, 3, 512);
+    REQUIRE(count == 3000);
+
+    std::istringstream ordered_in(input + "{\"id\": 3000}");
+    std::vector<size_t> ids;
+    json::for_each_line_ordered(ordered_in, record_id, [&](size_t id){ ids.push_back(id); }, 3, 100);
+    REQUIRE(ids.size() == 3001);
+    for(size_t i = 0; i < ids.size(); ++i)
+        REQUIRE(ids[i] == i);
+}
+
+TEST_CASE("JSON lines exceptions")
+{
+    const std::string input = make_lines(1000);
+    auto throwing = [](string_view record){
+        if(record_id(record) == 500)
+            throw std::runtime_error("bad record");
+        return 0;
+    };
+    REQUIRE_THROWS_AS(json::for_each_line(string_view(input), throwing, 4, 100),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(json::for_each_line_ordered(string_view(input), throwing, [](int){}, 4, 100),
+                      std::runtime_error);
+}
+
+}
@@ -0,0 +1,107 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/json_tokenizer.hpp"
+#include "svbb/literals.hpp"
+#include "svbb/util.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::json;
+
+using token_type = json::token<char, std::char_traits<char>>;
+
+std::vector<token_type> all_tokens(string_view document)
+{
+    std::vector<token_type> tokens;
+    for(auto t : json::tokenize(document))
+        tokens.push_back(t);
+    return tokens;
+}
+
+// Tokens up to and with the first ERROR or END_DOCUMENT.
+std::vector<token_type> until_end(string_view document)
+{
+    json::detail::token_state<char, std::char_traits<char>> state(document);
+    std::vector<token_type> tokens;
+    while(!state.empty()){
+        state.split();
+        tokens.push_back(state.last_token());
+    }
+    return tokens;
+}
+
+TEST_CASE("JSON nested document")
+{
+    auto document = R"({"name": "svbb", "tags": ["a", "b\"c"], "size": -1.5e3,
+        "ok": true, "none": null, "nested": {"empty": {}, "list": []}})"_sv;
+    REQUIRE(all_tokens(document) == std::vector<token_type>{
+        {ELEMENT::START_DOCUMENT},
+        {ELEMENT::START_OBJECT, ""_sv, ""_sv, 1},
+        {ELEMENT::STRING, "name"_sv, "svbb"_sv, 1},
+        {ELEMENT::START_ARRAY, "tags"_sv, ""_sv, 2},
+        {ELEMENT::STRING, ""_sv, "a"_sv, 2},
+        {ELEMENT::STRING, ""_sv, R"(b\"c)"_sv, 2},
+        {ELEMENT::END_ARRAY, ""_sv, ""_sv, 1},
+        {ELEMENT::NUMBER, "size"_sv, "-1.5e3"_sv, 1},
+        {ELEMENT::BOOLEAN, "ok"_sv, "true"_sv, 1},
+        {ELEMENT::NILL, "none"_sv, "null"_sv, 1},
+        {ELEMENT::START_OBJECT, "nested"_sv, ""_sv, 2},
+        {ELEMENT::START_OBJECT, "empty"_sv, ""_sv, 3},
+        {ELEMENT::END_OBJECT, ""_sv, ""_sv, 2},
+        {ELEMENT::START_ARRAY, "list"_sv, ""_sv, 3},
+        {ELEMENT::END_ARRAY, ""_sv, ""_sv, 2},
+        {ELEMENT::END_OBJECT, ""_sv, ""_sv, 1},
+        {ELEMENT::END_OBJECT, ""_sv, ""_sv, 0}});
+}
+
+TEST_CASE("JSON scalar documents")
+{
+    REQUIRE(until_end(" 42 "_sv) == std::vector<token_type>{
+        {ELEMENT::START_DOCUMENT}, {ELEMENT::NUMBER, ""_sv, "42"_sv}, {ELEMENT::END_DOCUMENT}});
+    REQUIRE(until_end(R"("x")"_sv) == std::vector<token_type>{
+        {ELEMENT::START_DOCUMENT}, {ELEMENT::STRING, ""_sv, "x"_sv}, {ELEMENT::END_DOCUMENT}});
+}
+
+TEST_CASE("JSON strings across blocks")
+{
+    // Structural characters, escaped quotes and backslash runs inside strings, at every
+    // alignment against the 64 byte blocks.
+    for(size_t pad = 0; pad < 70; ++pad){
+        const std::string text = std::string(pad, 'x') + R"(a\\\"b{[,:]}\\)";
+        const std::string document = R"({"k": [")" + text + R"(", 1]})";
+        const auto tokens = all_tokens(document);
+        REQUIRE(tokens.size() == 7);
+        REQUIRE(tokens[3] == token_type{ELEMENT::STRING, ""_sv, text, 2});
+        REQUIRE(tokens[4] == token_type{ELEMENT::NUMBER, ""_sv, "1"_sv, 2});
+    }
+}
+
+TEST_CASE("JSON errors")
+{
+    for(auto document : {R"({"a" 1})"_sv, R"({"a": tru})"_sv, R"([1 2])"_sv, R"([1,])"_sv,
+                         R"({"a": 1])"_sv, R"({"a": "open)"_sv, R"({1: 2})"_sv, R"([1] x)"_sv,
+                         R"([)"_sv, ""_sv}){
+        INFO(document);
+        REQUIRE(until_end(document).back().element == ELEMENT::ERROR);
+    }
+}
+
+TEST_CASE("JSON numbers")
+{
+    for(auto document : {"0"_sv, "-0"_sv, "12"_sv, "-3.25"_sv, "1e5"_sv, "1E+5"_sv, "0.5e-10"_sv}){
+        INFO(document);
+        const auto tokens = until_end(document);
+        REQUIRE(tokens[1].element == ELEMENT::NUMBER);
+        REQUIRE(tokens[1].value == document);
+    }
+    for(auto document : {"-"_sv, "01"_sv, "-01"_sv, "1-2e"_sv, "1."_sv, ".5"_sv, "1e"_sv,
+                         "1e+"_sv, "+1"_sv, "1.e3"_sv, "[1, -]"_sv, "[2, 1e5.0]"_sv}){
+        INFO(document);
+        REQUIRE(until_end(document).back().element == ELEMENT::ERROR);
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/kv.hpp"
+#include "svbb/literals.hpp"
+#include "svbb/util.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+template<typename Map>
+std::vector<std::string> flatten(const Map& map)
+{
+    std::vector<std::string> out;
+    for(const auto& p : map)
+        out.push_back(std::string(p.key) + "|" + std::string(p.value));
+    return out;
+}
+
+TEST_CASE("kv query string")
+{
+    using Catch::Matchers::Equals;
+    auto query = kv::parse("q=svbb&page=2&&flag&expr=a=b&=empty&last="_sv, '&', '=');
+    REQUIRE_THAT(flatten(query), Equals(std::vector<std::string>{
+        "q|svbb", "page|2", "flag|", "expr|a=b", "|empty", "last|"}));
+    REQUIRE(query.get("page"_sv) == "2"_sv);
+    REQUIRE(query.get("expr"_sv) == "a=b"_sv);
+    REQUIRE(query.contains("flag"_sv));
+    REQUIRE_FALSE(query.contains("missing"_sv));
+    REQUIRE(query.get("missing"_sv, "default"_sv) == "default"_sv);
+    REQUIRE(query.find("missing"_sv) == nullptr);
+}
+
+TEST_CASE("kv trimmed pairs")
+{
+    using Catch::Matchers::Equals;
+    auto cookies = kv::parse(" session = abc ;theme=dark;  ; lang= en"_sv, ';', '=', " \t"_sv);
+    REQUIRE_THAT(flatten(cookies), Equals(std::vector<std::string>{
+        "session|abc", "theme|dark", "lang|en"}));
+    REQUIRE(cookies.get("lang"_sv) == "en"_sv);
+}
+
+TEST_CASE("kv spills past the inline capacity")
+{
+    std::string input;
+    for(int i = 0; i < 40; ++i)
+        input += "k" + std::to_string(i) + "=" + std::to_string(i * i) + "&";
+    auto map = kv::parse(string_view(input), '&', '=');
+    REQUIRE(map.size() == 40);
+    REQUIRE(map.get("k3"_sv) == "9"_sv);
+    REQUIRE(map.get("k39"_sv) == "1521"_sv);
+    REQUIRE(map[20].key == "k20"_sv);
+
+    kv::flat_map<char, std::char_traits<char>, 4> small;
+    for(int i = 0; i < 6; ++i)
+        small.push_back({"k"_sv, "v"_sv});
+    REQUIRE(small.size() == 6);
+    REQUIRE(std::distance(small.begin(), small.end()) == 6);
+}
+
+TEST_CASE("kv empty input")
+{
+    REQUIRE(kv::parse(""_sv, '&', '=').empty());
+    REQUIRE(kv::parse("&&&"_sv, '&', '=').empty());
+}
+
+}
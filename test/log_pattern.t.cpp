@@ -0,0 +1,68 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/log_pattern.hpp"
+#include "svbb/literals.hpp"
+#include "svbb/util.hpp"
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+constexpr char common_log[] = "%s %s %s [%s] \"%s\" %d %d";
+constexpr char syslog[] = "<%d>%s %s %s: %s";
+constexpr char percent[] = "%d%% of %s";
+constexpr char no_fields[] = "-- MARK --";
+
+static_assert(log_pattern<common_log>::size == 7, "");
+static_assert(log_pattern<syslog>::size == 5, "");
+static_assert(log_pattern<percent>::size == 2, "");
+static_assert(log_pattern<no_fields>::size == 0, "");
+
+TEST_CASE("log_pattern common log format")
+{
+    std::array<string_view, log_pattern<common_log>::size> f;
+    REQUIRE(log_pattern<common_log>::match(
+        "127.0.0.1 - frank [10/Oct/2000:13:55:36 -0700] \"GET /apache_pb.gif HTTP/1.0\" 200 2326"_sv,
+        f));
+    REQUIRE(f[0] == "127.0.0.1"_sv);
+    REQUIRE(f[1] == "-"_sv);
+    REQUIRE(f[2] == "frank"_sv);
+    REQUIRE(f[3] == "10/Oct/2000:13:55:36 -0700"_sv);
+    REQUIRE(f[4] == "GET /apache_pb.gif HTTP/1.0"_sv);
+    REQUIRE(f[5] == "200"_sv);
+    REQUIRE(f[6] == "2326"_sv);
+
+    // Wrong literal, not a number, missing and trailing text.
+    REQUIRE_FALSE(log_pattern<common_log>::match("a b c (d) \"e\" 1 2"_sv, f));
+    REQUIRE_FALSE(log_pattern<common_log>::match("a b c [d] \"e\" 1 x"_sv, f));
+    REQUIRE_FALSE(log_pattern<common_log>::match("a b c [d] \"e\" 1"_sv, f));
+    REQUIRE_FALSE(log_pattern<common_log>::match("a b c [d] \"e\" 1 2 "_sv, f));
+    REQUIRE_FALSE(log_pattern<common_log>::match(""_sv, f));
+}
+
+TEST_CASE("log_pattern syslog")
+{
+    std::array<string_view, log_pattern<syslog>::size> f;
+    REQUIRE(log_pattern<syslog>::match(
+        "<34>Oct-11 mymachine su: 'su root' failed for lonvick on /dev/pts/8"_sv, f));
+    REQUIRE(f[0] == "34"_sv);
+    REQUIRE(f[1] == "Oct-11"_sv);
+    REQUIRE(f[2] == "mymachine"_sv);
+    REQUIRE(f[3] == "su"_sv);
+    REQUIRE(f[4] == "'su root' failed for lonvick on /dev/pts/8"_sv);
+}
+
+TEST_CASE("log_pattern literals")
+{
+    std::array<string_view, log_pattern<percent>::size> f;
+    REQUIRE(log_pattern<percent>::match("-42% of all"_sv, f));
+    REQUIRE(f[0] == "-42"_sv);
+    REQUIRE(f[1] == "all"_sv);
+    REQUIRE_FALSE(log_pattern<percent>::match("-% of all"_sv, f));
+
+    std::array<string_view, 0> none;
+    REQUIRE(log_pattern<no_fields>::match("-- MARK --"_sv, none));
+    REQUIRE_FALSE(log_pattern<no_fields>::match("-- MARK"_sv, none));
+}
+
+}
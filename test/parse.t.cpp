@@ -0,0 +1,82 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/parse.hpp"
+#include "svbb/util.hpp"
+#include "svbb/literals.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+
+TEST_CASE("parse integers")
+{
+    REQUIRE(parse<int>("42"_sv).ok());
+    REQUIRE(parse<int>("42"_sv).value == 42);
+    REQUIRE(parse<std::int64_t>("-9223372036854775808"_sv).value == INT64_MIN);
+    REQUIRE(parse<std::uint8_t>("255"_sv).value == 255);
+    REQUIRE(parse<std::uint8_t>("256"_sv).error == std::errc::result_out_of_range);
+    REQUIRE(parse<unsigned>("-1"_sv).error == std::errc::invalid_argument);
+    REQUIRE(parse<int>(""_sv).error == std::errc::invalid_argument);
+    REQUIRE(parse<int>(" 1"_sv).error == std::errc::invalid_argument);
+    REQUIRE(parse<int>("1 "_sv).error == std::errc::invalid_argument);
+    REQUIRE(parse<int>("12ab"_sv).error == std::errc::invalid_argument);
+    // Only the view is read, not what follows it.
+    REQUIRE(parse<int>("123456"_sv.substr(1, 3)).value == 234);
+}
+
+TEST_CASE("parse floating point")
+{
+    REQUIRE(parse<double>("3.25"_sv).value == 3.25);
+    REQUIRE(parse<double>("-1e-3"_sv).value == -1e-3);
+    REQUIRE(parse<float>("0.5"_sv).value == 0.5f);
+    REQUIRE(parse<double>("1e999"_sv).error == std::errc::result_out_of_range);
+    REQUIRE(parse<double>("."_sv).error == std::errc::invalid_argument);
+    REQUIRE(parse<double>("1.5x"_sv).error == std::errc::invalid_argument);
+}
+
+TEST_CASE("tokenize_as")
+{
+    using Catch::Matchers::Equals;
+    auto ints = tokenize_as<std::int64_t>("1,-2,30000000000"_sv, ',');
+    REQUIRE_THAT(std::vector<std::int64_t>(ints.begin(), ints.end()),
+                 Equals(std::vector<std::int64_t>{1, -2, 30000000000}));
+
+    auto doubles = tokenize_as<double>("0.5;1.25"_sv, split_by_char<char>(';'));
+    REQUIRE_THAT(std::vector<double>(doubles.begin(), doubles.end()),
+                 Equals(std::vector<double>{0.5, 1.25}));
+}
+
+TEST_CASE("tokenize_as error policies")
+{
+    using Catch::Matchers::Equals;
+    const auto input = "1,x,3,99999999999,5"_sv;
+
+    auto throwing = tokenize_as<int>(input, ',');
+    REQUIRE_THROWS_AS(std::vector<int>(throwing.begin(), throwing.end()), std::invalid_argument);
+    auto too_large = tokenize_as<int>("1,99999999999"_sv, ',');
+    REQUIRE_THROWS_AS(std::vector<int>(too_large.begin(), too_large.end()), std::out_of_range);
+
+    parse_status skipped;
+    auto skipping = tokenize_as<int, ON_ERROR::SKIP>(input, ',', &skipped);
+    REQUIRE_THAT(std::vector<int>(skipping.begin(), skipping.end()),
+                 Equals(std::vector<int>{1, 3, 5}));
+    REQUIRE_FALSE(skipped.ok());
+    REQUIRE(skipped.error == std::errc::invalid_argument);
+    REQUIRE(skipped.offset == 2);
+
+    parse_status stopped;
+    auto stopping = tokenize_as<int, ON_ERROR::STOP>(input, ',', &stopped);
+    REQUIRE_THAT(std::vector<int>(stopping.begin(), stopping.end()),
+                 Equals(std::vector<int>{1}));
+    REQUIRE(stopped.offset == 2);
+    REQUIRE(stopped.skipped == 0);
+
+    parse_status fine;
+    auto all = tokenize_as<int, ON_ERROR::STOP>("7,8"_sv, ',', &fine);
+    REQUIRE(std::distance(all.begin(), all.end()) == 2);
+    REQUIRE(fine.ok());
+}
+
+}
@@ -0,0 +1,109 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/simd.hpp"
+#include <string>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+
+TEST_CASE("SWAR byte masks")
+{
+    const std::uint64_t word = simd::load64("ab\0d<f<h");
+    REQUIRE(simd::first_byte(simd::zero_bytes(word)) == 2);
+    REQUIRE(simd::first_byte(simd::equal_bytes(word, '<')) == 4);
+    REQUIRE(simd::equal_bytes(word, 'z') == 0);
+    // No false positives next to a match.
+    REQUIRE(simd::equal_bytes(simd::load64("\x01\x00\x01\x01\x01\x01\x01\x01"), 0)
+            == (simd::broadcast(0x80) & 0xff00ull));
+}
+
+TEST_CASE("find_first_of at every offset")
+{
+    for(size_t length = 0; length < 70; ++length){
+        for(size_t pos = 0; pos <= length; ++pos){
+            std::string text(length, 'x');
+            if(pos < length)
+                text[pos] = (pos % 2) ? '&' : '<';
+            REQUIRE(simd::find_first_of(text.data(), text.size(), "<&", 2) == pos);
+        }
+    }
+}
+
+TEST_CASE("block64 masks")
+{
+    std::string data(64, 'x');
+    data[0] = '{';
+    data[17] = '{';
+    data[63] = '{';
+    const simd::block64 block(data.data());
+    REQUIRE(block.equal('{') == ((1ull << 0) | (1ull << 17) | (1ull << 63)));
+    REQUIRE(block.equal('}') == 0);
+}
+
+TEST_CASE("prefix_xor")
+{
+    REQUIRE(simd::prefix_xor(0) == 0);
+    REQUIRE(simd::prefix_xor(0b1001000) == 0b0111000);
+    REQUIRE(simd::prefix_xor(1ull << 63) == 1ull << 63);
+}
+
+// Escaped characters of 'text' the slow way.
+std::uint64_t escaped_reference(const std::string& text, bool& carry)
+{
+    std::uint64_t bits = 0;
+    for(size_t i = 0; i < text.size(); ++i){
+        if(carry){
+            bits |= 1ull << i;
+            carry = false;
+        } else if(text[i] == '\\') {
+            carry = true;
+        }
+    }
+    return bits;
+}
+
+TEST_CASE("escaped_bits against a reference")
+{
+    // Blocks made of backslashes and letters, chained so runs cross block boundaries.
+    std::uint64_t pattern = 0x9e3779b97f4a7c15ull;
+    bool reference_carry = false;
+    std::uint64_t carry = 0;
+    for(int block = 0; block < 500; ++block){
+        pattern ^= pattern << 13;
+        pattern ^= pattern >> 7;
+        pattern ^= pattern << 17;
+        std::string text(64, 'a');
+        std::uint64_t backslash = 0;
+        for(size_t i = 0; i < 64; ++i){
+            // Mostly backslashes, to get long runs.
+            if(((pattern >> i) & 1) || ((pattern >> ((i + 7) % 64)) & 1)){
+                text[i] = '\\';
+                backslash |= 1ull << i;
+            }
+        }
+        REQUIRE(simd::escaped_bits(backslash, carry) == escaped_reference(text, reference_carry));
+        REQUIRE((carry != 0) == reference_carry);
+    }
+}
+
+TEST_CASE("ascii_lower folds every byte")
+{
+    for(int c = 0; c < 256; ++c){
+        const unsigned char byte = static_cast<unsigned char>(c);
+        const unsigned char expected = (byte >= 'A' && byte <= 'Z') ? byte + 32 : byte;
+        // The byte at the bottom, 'A' in all the others.
+        const std::uint64_t word = (simd::broadcast('A') & ~0xffull) | byte;
+        const std::uint64_t folded = simd::ascii_lower(word);
+        REQUIRE((folded & 0xff) == expected);
+        REQUIRE((folded >> 8) == (simd::broadcast('a') >> 8));
+#ifdef SVBB_HAS_SSE2
+        unsigned char out[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         simd::ascii_lower(_mm_set1_epi8(static_cast<char>(byte))));
+        REQUIRE(out[0] == expected);
+        REQUIRE(out[15] == expected);
+#endif
+    }
+}
+
+}
@@ -94,4 +94,40 @@ TEST_CASE("split on a delimiter list, leave delimiter in first part")
     REQUIRE(split_after("abc"_sv, "xc"_sv) == make_split("abc"_sv, ""_sv));
 }
 
+TEST_CASE("split_n")
+{
+    auto date = split_n<3>("2024-05-17"_sv, '-');
+    REQUIRE(date.complete());
+    REQUIRE(date.count == 3);
+    REQUIRE(date.fields[0] == "2024"_sv);
+    REQUIRE(date.fields[1] == "05"_sv);
+    REQUIRE(date.fields[2] == "17"_sv);
+
+    auto rest = split_n<2>("key=a=b"_sv, '=');
+    REQUIRE(rest.complete());
+    REQUIRE(rest.fields[1] == "a=b"_sv);
+
+    auto short_input = split_n<4>("a,,b"_sv, ',');
+    REQUIRE_FALSE(short_input.complete());
+    REQUIRE(short_input.count == 3);
+    REQUIRE(short_input.fields[1] == ""_sv);
+    REQUIRE(short_input.fields[2] == "b"_sv);
+    REQUIRE(short_input.fields[3] == ""_sv);
+
+    REQUIRE(split_n<1>("a,b"_sv, ',').fields[0] == "a,b"_sv);
+    REQUIRE(split_n<2>(""_sv, ',').count == 1);
+    REQUIRE(split_n<2>(","_sv, ',').complete());
+}
+
+TEST_CASE("split_n constexpr")
+{
+    constexpr auto r = split_n<3>("a;bc;d;e"_svc, ';');
+    static_assert(r.complete(), "");
+    static_assert(r.fields[0] == "a"_svc, "");
+    static_assert(r.fields[1] == "bc"_svc, "");
+    static_assert(r.fields[2] == "d;e"_svc, "");
+    static_assert(split_n<3>("a"_svc, ';').count == 1, "");
+    REQUIRE(r.complete());
+}
+
 } // namespace
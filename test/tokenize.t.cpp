@@ -5,6 +5,10 @@
 #include "svbb/literals.hpp"
 #include <array>
 #include <vector>
+#if defined(__cpp_lib_ranges)
+#include <algorithm>
+#include <ranges>
+#endif
 
 namespace {
 using namespace SVBB_NAMESPACE;
@@ -58,4 +62,50 @@ TEST_CASE("tokenize trimmed")
     require_range_equal(tokenize("  abc  ,"_sv, delimeter, whitespace), {"abc"});
     require_range_equal(tokenize("a,bc, def"_sv, delimeter, whitespace), {"a", "bc", "def"});
 }
+
+TEST_CASE("tokenize with UTF-8 validation")
+{
+    utf8::status valid;
+    require_range_equal(
+        tokenize("caf\xc3\xa9,\xe2\x82\xac,x"_sv, check_utf8(split_by_char<char>(','), valid)),
+        {"caf\xc3\xa9"_sv, "\xe2\x82\xac"_sv, "x"_sv});
+    REQUIRE(valid.valid());
+
+    utf8::status invalid;
+    require_range_equal(tokenize("a,b,c\xff,d"_sv, check_utf8(split_by_char<char>(','), invalid)),
+                        {"a"_sv, "b"_sv});
+    REQUIRE(invalid.error_offset == 5);
+
+    utf8::status truncated;
+    require_range_equal(tokenize("a,\xe2\x82"_sv, check_utf8(split_by_char<char>(','), truncated)),
+                        {"a"_sv});
+    REQUIRE(truncated.error_offset == 2);
+}
+
+TEST_CASE("tokenize iterator valid")
+{
+    auto rng = tokenize("a,b"_sv, ',');
+    REQUIRE(rng.begin().valid());
+    REQUIRE_FALSE(rng.end().valid());
+}
+
+#if defined(__cpp_lib_ranges)
+static_assert(std::ranges::forward_range<token_range<char, std::char_traits<char>,
+                                                     split_by_char<char>>>);
+static_assert(std::ranges::view<token_range<char, std::char_traits<char>, split_by_char<char>>>);
+static_assert(
+    std::ranges::borrowed_range<token_range<char, std::char_traits<char>, split_by_char<char>>>);
+
+TEST_CASE("tokenize with std::ranges")
+{
+    auto fields = tokenize("a,bb,,ccc,d"_sv, ',') | std::views::drop(1) |
+                  std::views::filter([](string_view s){ return !s.empty(); }) |
+                  std::views::take(2) | std::views::common;
+    require_range_equal(fields, {"bb", "ccc"});
+    REQUIRE(std::ranges::count(tokenize("a,b,c"_sv, ','), "b"_sv) == 1);
+    // A borrowed range, iterators can outlive the range.
+    auto it = std::ranges::find(tokenize("a,b,c"_sv, ','), "b"_sv);
+    REQUIRE(*it == "b"_sv);
+}
+#endif
 } // namespace
@@ -86,4 +86,22 @@ TEST_CASE("trim multiple characters")
     REQUIRE(trim(" \t abcd \t"_sv, " \t"_sv) == "abcd");
     REQUIRE(trim(" \t abcd "_sv, " \tabcd"_sv) == "");
 }
+
+TEST_CASE("trim char_set")
+{
+    const char_set ws(" \t\r");
+    REQUIRE(ws.contains(' '));
+    REQUIRE(ws.contains('\r'));
+    REQUIRE_FALSE(ws.contains('a'));
+    REQUIRE_FALSE(ws.contains('\xa0'));
+    REQUIRE_FALSE(ws.contains(u'\u0120'));
+
+    REQUIRE(trim(""_sv, ws) == "");
+    REQUIRE(trim(" \t\r"_sv, ws) == "");
+    REQUIRE(trim(" \t ab c \r"_sv, ws) == "ab c");
+    REQUIRE(trim_left(" \t ab c \r"_sv, ws) == "ab c \r");
+    REQUIRE(trim_right(" \t ab c \r"_sv, ws) == " \t ab c");
+    REQUIRE(trim(" abcd "_sv, char_set(" abcd"_sv)) == "");
+    REQUIRE(trim("abcd"_sv, char_set("")) == "abcd");
+}
 } // namespace
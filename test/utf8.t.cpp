@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/utf8.hpp"
+#include <string>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+
+size_t check(const std::string& input) { return utf8::validate(string_view(input)); }
+
+TEST_CASE("UTF-8 valid input")
+{
+    REQUIRE(check("") == utf8::validator::npos);
+    REQUIRE(check("plain ascii, long enough to take the block path") == utf8::validator::npos);
+    REQUIRE(check("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf") == utf8::validator::npos);
+    REQUIRE(check("\xed\x9f\xbf\xee\x80\x80") == utf8::validator::npos);
+}
+
+TEST_CASE("UTF-8 invalid input")
+{
+    REQUIRE(check("abc\x80") == 3);                     // lone continuation
+    REQUIRE(check("ab\xc0\xaf") == 2);                  // overlong
+    REQUIRE(check("\xe0\x9f\xbf") == 0);                // overlong
+    REQUIRE(check("x\xed\xa0\x80") == 1);               // surrogate
+    REQUIRE(check("\xf4\x90\x80\x80") == 0);            // above U+10FFFF
+    REQUIRE(check("\xf5\x80\x80\x80") == 0);
+    REQUIRE(check("0123456789abcdef0123\xc3(") == 20);  // bad continuation
+    REQUIRE(check("truncated \xe2\x82") == 10);
+}
+
+TEST_CASE("UTF-8 fed in pieces")
+{
+    const std::string text = "\xe2\x82\xac\xf0\x9f\x98\x80 ok";
+    for(size_t cut = 0; cut <= text.size(); ++cut){
+        utf8::validator v;
+        REQUIRE(v.feed(text.data(), cut));
+        REQUIRE(v.feed(text.data() + cut, text.size() - cut));
+        REQUIRE(v.finish());
+        REQUIRE(v.size() == text.size());
+    }
+
+    utf8::validator v;
+    REQUIRE(v.feed("abc\xe2", 4));
+    REQUIRE_FALSE(v.feed("x", 1));
+    REQUIRE(v.error_offset() == 3);
+    REQUIRE_FALSE(v.feed("abc", 3));
+}
+
+}
@@ -0,0 +1,67 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_compact_token.hpp"
+#include "svbb/util.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+TEST_CASE("Compact token size")
+{
+    REQUIRE(sizeof(compact_token) == 16);
+    REQUIRE(sizeof(compact_token) * 3 <= sizeof(token<char, std::char_traits<char>>) * 2);
+}
+
+TEST_CASE("Compact token round trip")
+{
+    auto document = "<?xml version=\"1.0\"?>"
+        "<ROOT a=\"1\"><svbb:node test=\"true\">Some text</svbb:node><EMPTY/></ROOT>"_sv;
+
+    for(auto t : tokenize(document)){
+        auto compact = compact_token::make(t, document);
+        REQUIRE(compact.element() == t.element);
+        REQUIRE(compact.qname(document) == t.qname);
+        REQUIRE(compact.value(document) == t.value);
+        REQUIRE(compact.expand(document) == t);
+
+        if(!t.qname.empty())
+            REQUIRE(compact.qname(document).data() == t.qname.data());
+        if(!t.value.empty())
+            REQUIRE(compact.value(document).data() == t.value.data());
+    }
+}
+
+TEST_CASE("Compact token defaults")
+{
+    auto document = "<ROOT/>"_sv;
+    compact_token empty;
+    REQUIRE(empty.element() == ELEMENT::END_DOCUMENT);
+    REQUIRE(empty.expand(document) == token{ELEMENT::END_DOCUMENT, ""_sv, ""_sv});
+
+    auto error = compact_token::make(token{ELEMENT::ERROR, "message"_sv}, document);
+    REQUIRE(error.element() == ELEMENT::ERROR);
+    REQUIRE(error.value(document).empty());
+}
+
+TEST_CASE("Compact token limits")
+{
+    const std::string name(compact_token::max_qname_size + 1, 'n');
+    const std::string document = "<" + name + "/>";
+    const auto view = make_view(document);
+    const token<char, std::char_traits<char>> long_name{ELEMENT::START_ELEMENT,
+                                                        view.substr(1, name.size())};
+    REQUIRE_THROWS_AS(compact_token::make(long_name, view), std::length_error);
+
+    // Offsets count from the base given.
+    const auto part = view.substr(1, 100);
+    auto compact = compact_token::make(token{ELEMENT::CHARACTERS, part.substr(10, 5)}, part);
+    REQUIRE(compact.value_offset == 10);
+    REQUIRE(compact.value(part).data() == part.data() + 10);
+}
+
+}
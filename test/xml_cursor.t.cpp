@@ -0,0 +1,71 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_cursor.hpp"
+#include "svbb/util.hpp"
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+using cursor_type = cursor<char, std::char_traits<char>>;
+
+TEST_CASE("Cursor is move only")
+{
+    static_assert(!std::is_copy_constructible<cursor_type>::value, "");
+    static_assert(!std::is_copy_assignable<cursor_type>::value, "");
+    static_assert(std::is_move_constructible<cursor_type>::value, "");
+    static_assert(std::is_move_assignable<cursor_type>::value, "");
+}
+
+TEST_CASE("Cursor walks the document")
+{
+    using Catch::Matchers::Equals;
+    auto c = make_cursor("<ROOT a=\"1\"><node>text</node><EMPTY/></ROOT>"_sv);
+    std::vector<std::string> seen;
+    std::vector<size_t> depths;
+    while(c.next()){
+        switch(c.kind()){
+            case ELEMENT::START_ELEMENT: seen.push_back("<" + std::string(c.name())); break;
+            case ELEMENT::END_ELEMENT: seen.push_back(">" + std::string(c.name())); break;
+            case ELEMENT::ELEMENT_ATTRIBUTE:
+                seen.push_back("@" + std::string(c.name()) + "=" + std::string(c.value()));
+                break;
+            case ELEMENT::CHARACTERS: seen.push_back("'" + std::string(c.value()) + "'"); break;
+            default: seen.push_back("-"); break;
+        }
+        depths.push_back(c.depth());
+    }
+    REQUIRE_THAT(seen, Equals(std::vector<std::string>{
+        "-", "<ROOT", "@a=1", "<node", "'text'", ">node", "<EMPTY", ">EMPTY", ">ROOT", "-"}));
+    REQUIRE(depths == std::vector<size_t>{0, 1, 1, 2, 2, 1, 2, 1, 0, 0});
+    REQUIRE(c.kind() == ELEMENT::END_DOCUMENT);
+    REQUIRE_FALSE(c.next());
+}
+
+TEST_CASE("Cursor skips and moves")
+{
+    auto c = make_cursor("<ROOT><big><a/><b>x</b></big><small>y</small></ROOT>"_sv);
+    REQUIRE(c.skip_to_element("big"_sv));
+    REQUIRE(c.skip_subtree());
+    REQUIRE(c.kind() == ELEMENT::END_ELEMENT);
+    REQUIRE(c.name() == "big"_sv);
+
+    cursor_type moved = std::move(c);
+    REQUIRE(moved.next());
+    REQUIRE(moved.name() == "small"_sv);
+    REQUIRE(moved.next());
+    REQUIRE(moved.value() == "y"_sv);
+}
+
+TEST_CASE("Cursor stops on errors")
+{
+    auto c = make_cursor("<ROOT><a></ROOT"_sv);
+    while(c.next()) {}
+    REQUIRE(c.kind() == ELEMENT::ERROR);
+}
+
+}
@@ -0,0 +1,68 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_names.hpp"
+#include "svbb/util.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+constexpr auto names = make_name_table("feed"_sv, "entry"_sv, "price"_sv, "id"_sv, "name"_sv);
+
+TEST_CASE("Name table lookup")
+{
+    static_assert(names.id("feed"_sv) == 0, "");
+    static_assert(names.id("price"_sv) == 2, "");
+    static_assert(names.id("unknown"_sv) == names.npos, "");
+
+    for(size_t i = 0; i < names.size(); ++i)
+        REQUIRE(names.id(names.name(i)) == i);
+    REQUIRE(names.id(""_sv) == names.npos);
+    REQUIRE(names.id("pric"_sv) == names.npos);
+    REQUIRE(names.id("prices"_sv) == names.npos);
+}
+
+TEST_CASE("Name table with many names")
+{
+    std::vector<std::string> storage;
+    for(int i = 0; i < 200; ++i)
+        storage.push_back("element" + std::to_string(i * 37));
+
+    std::array<string_view, 200> views;
+    for(size_t i = 0; i < views.size(); ++i)
+        views[i] = storage[i];
+
+    const name_table<char, std::char_traits<char>, 200> table(views);
+    for(size_t i = 0; i < views.size(); ++i)
+        REQUIRE(table.id(views[i]) == i);
+    REQUIRE(table.id("element1"_sv) == table.npos);
+}
+
+TEST_CASE("Tokenize with name ids")
+{
+    auto document = "<feed><entry id=\"1\" other=\"x\"><price>10</price></entry></feed>"_sv;
+
+    std::vector<size_t> ids;
+    for(const auto& t : tokenize(document, names)){
+        switch(t.name_id){
+            case names.id("price"_sv):
+                REQUIRE(t.qname == "price");
+                break;
+            case names.npos:
+                REQUIRE((t.qname.empty() || t.qname == "other"));
+                break;
+            default:
+                REQUIRE(names.name(t.name_id) == t.qname);
+                break;
+        }
+        ids.push_back(t.name_id);
+    }
+
+    const size_t unknown = names.npos;
+    REQUIRE(ids == std::vector<size_t>{unknown, 0, 1, 3, unknown, 2, unknown, 2, 1, 0});
+}
+
+}
@@ -0,0 +1,147 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_parallel.hpp"
+#include "svbb/util.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+using token_type = token<char, std::char_traits<char>>;
+
+std::vector<token_type> sequential(string_view document)
+{
+    std::vector<token_type> tokens;
+    detail::token_state<char, std::char_traits<char>> fsm(document);
+    while(!fsm.empty()){
+        fsm.split();
+        tokens.push_back(fsm.last_token());
+        tokens.back().depth = static_cast<int>(fsm.depth());
+    }
+    return tokens;
+}
+
+void require_same_tokens(string_view document, size_t threads, size_t min_chunk)
+{
+    const auto expected = sequential(document);
+    const auto tokens = parallel_tokenize(document, threads, min_chunk);
+    REQUIRE(tokens.size() == expected.size());
+    for(size_t i = 0; i < tokens.size(); ++i){
+        REQUIRE(tokens[i] == expected[i]);
+        REQUIRE(tokens[i].depth == expected[i].depth);
+    }
+}
+
+TEST_CASE("Parallel tokenize small document")
+{
+    auto document = "<ROOT><A x=\"1\">text</A><B/></ROOT>"_sv;
+    require_same_tokens(document, 1, 1);
+    require_same_tokens(document, 4, 1);
+    require_same_tokens(document, 64, 1);
+}
+
+TEST_CASE("Parallel tokenize mis-speculated chunks")
+{
+    // Chunk boundaries are placed at every '<', including the ones inside of comments and
+    // processing instructions.
+    auto document = "<?xml version=\"1.0\"?>\n"
+        "<?embedded <a><b></b></a>?>\n"
+        "<feed>\n"
+        "  <entry id=\"1\"><price>10</price><!-- <price>20</price> <open> --></entry>\n"
+        "  <entry id=\"2\" type=\"cd\"><empty a=\"b\"/><?pi <not></a>?>after</entry>\n"
+        "  <deep><deep><deep>bottom</deep></deep></deep>\n"
+        "</feed>\n"_sv;
+    for(size_t threads = 1; threads <= 32; ++threads)
+        require_same_tokens(document, threads, 1);
+}
+
+TEST_CASE("Parallel tokenize large document")
+{
+    std::string document = "<root>";
+    for(int i = 0; i < 2000; ++i){
+        document += "<item n=\"" + std::to_string(i) + "\"><v>" + std::to_string(i * 7)
+                    + "</v><!-- <v>skip</v> --><e/></item>\n";
+    }
+    document += "</root>";
+    require_same_tokens(make_view(document), 8, 1024);
+    require_same_tokens(make_view(document), 3, 1);
+}
+
+TEST_CASE("Parallel tokenize attribute-like text in markup")
+{
+    // Chunks that start at these '<' see a tag with something that is not an attribute.
+    const string_view documents[] = {
+        "<r><a><!-- <x y> --></a></r>"_sv,
+        "<r><!-- <x y=> <x y=\"> <x =''> --><a b='1' c = \"2\"/></r>"_sv,
+        "<r><?pi <x y> <x y=\"1> ?><a/></r>"_sv,
+        "<r><a><![CDATA[ <x y> ]]></a></r>"_sv,
+    };
+    for(auto document : documents){
+        for(size_t threads = 1; threads <= document.size(); ++threads)
+            require_same_tokens(document, threads, 1);
+    }
+}
+
+TEST_CASE("Parallel tokenize keeps failed speculation quiet")
+{
+    std::ostringstream log;
+    auto* old = std::cerr.rdbuf(log.rdbuf());
+    require_same_tokens("<r/><!-- c -->"_sv, 4, 1);
+    require_same_tokens("<r><!-- <x y> --></r>"_sv, 8, 1);
+    std::cerr.rdbuf(old);
+    REQUIRE(log.str().empty());
+}
+
+TEST_CASE("Parallel tokenize tokens too large for compact_token")
+{
+    // The chunk with the long name can't be buffered, it is tokenized again in order.
+    std::string document = "<root><a>" + std::string(30000, 'x') + "</a><";
+    document += std::string(compact_token::max_qname_size + 1, 'n');
+    document += " x=\"1\"/><b>2</b></root>";
+    require_same_tokens(make_view(document), 4, 1);
+}
+
+// parallel_tokenize() at every chunking against tokenize(): the tokens it iterates over, then
+// the END_DOCUMENT or ERROR token that ended the document.
+void require_like_tokenize(string_view document)
+{
+    std::vector<token_type> expected;
+    for(auto t : tokenize(document))
+        expected.push_back(t);
+    expected.push_back(sequential(document).back());
+    for(size_t threads = 1; threads <= document.size(); ++threads){
+        const auto tokens = parallel_tokenize(document, threads, 1);
+        REQUIRE(tokens.size() == expected.size());
+        for(size_t i = 0; i < tokens.size(); ++i)
+            REQUIRE(tokens[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Parallel tokenize markup after the root element")
+{
+    std::ostringstream log;
+    auto* old = std::cerr.rdbuf(log.rdbuf());
+    require_like_tokenize("<r><a>x</a><!-- c --></r>\n<!-- tail -->"_sv);
+    require_like_tokenize("<r><e/><?pi d?><!-- <x y> --> </r><!-- <x y> --><?pi d?>"_sv);
+    require_like_tokenize("<r/><?pi <a><b>?>\n<!-- <c> -->\n"_sv);
+    std::cerr.rdbuf(old);
+    REQUIRE(log.str().empty());
+}
+
+TEST_CASE("Parallel tokenize truncated documents")
+{
+    std::ostringstream log;
+    auto* old = std::cerr.rdbuf(log.rdbuf());
+    require_like_tokenize("<r><a>x</a"_sv);
+    require_like_tokenize("<r><a>text"_sv);
+    require_like_tokenize("<r><!-- c --><!-- c --><e/><!-- c --><b x=\"1\"></r>"_sv);
+    require_like_tokenize("<r><a><!-- open"_sv);
+    std::cerr.rdbuf(old);
+}
+
+}
@@ -0,0 +1,125 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_query.hpp"
+#include "svbb/util.hpp"
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+const auto feed = "<?xml version=\"1.0\"?>\n"
+    "<feed>\n"
+    "  <title>Prices</title>\n"
+    "  <entry id=\"1\" type=\"book\"><name>A</name><price>10</price></entry>\n"
+    "  <entry id=\"2\" type=\"cd\"><name>B</name><price>20</price>\n"
+    "    <payload><price>nested</price><!-- <price>no</price> --></payload></entry>\n"
+    "  <entry id=\"3\" type=\"book\"/>\n"
+    "  <extra><entry><price>30</price></entry></extra>\n"
+    "</feed>"_sv;
+
+template<typename Range>
+std::vector<string_view> collect(Range&& rng)
+{
+    return std::vector<string_view>(rng.begin(), rng.end());
+}
+
+TEST_CASE("Compile path")
+{
+    auto p = compile_path("/feed//entry[@type = 'book']/@id"_sv);
+    REQUIRE(p.valid());
+    REQUIRE(p.size() == 2);
+    REQUIRE(p[0].axis == AXIS::CHILD);
+    REQUIRE(p[0].qname == "feed");
+    REQUIRE(p[1].axis == AXIS::DESCENDANT);
+    REQUIRE(p[1].qname == "entry");
+    REQUIRE(p[1].attribute == "type");
+    REQUIRE(p[1].value == "book");
+    REQUIRE(p.attribute() == "id");
+
+    REQUIRE_FALSE(compile_path(""_sv).valid());
+    REQUIRE_FALSE(compile_path("feed"_sv).valid());
+    REQUIRE_FALSE(compile_path("/feed/"_sv).valid());
+    REQUIRE_FALSE(compile_path("/@id"_sv).valid());
+    REQUIRE_FALSE(compile_path("/feed[id]"_sv).valid());
+    REQUIRE_FALSE(compile_path("/feed[@id=\"1]"_sv).valid());
+    REQUIRE_FALSE(compile_path("/feed/@id/entry"_sv).valid());
+}
+
+TEST_CASE("Query child steps")
+{
+    using Catch::Matchers::Equals;
+    REQUIRE_THAT(collect(query(feed, "/feed/entry/price"_sv)),
+                 Equals(std::vector<string_view>{"10", "20"}));
+    REQUIRE_THAT(collect(query(feed, "/feed/title"_sv)), Equals(std::vector<string_view>{"Prices"}));
+    REQUIRE_THAT(collect(query(feed, "/feed/*/name"_sv)),
+                 Equals(std::vector<string_view>{"A", "B"}));
+    REQUIRE(collect(query(feed, "/entry/price"_sv)).empty());
+}
+
+TEST_CASE("Query descendant steps")
+{
+    using Catch::Matchers::Equals;
+    REQUIRE_THAT(collect(query(feed, "//price"_sv)),
+                 Equals(std::vector<string_view>{"10", "20", "nested", "30"}));
+    REQUIRE_THAT(collect(query(feed, "/feed//entry/price"_sv)),
+                 Equals(std::vector<string_view>{"10", "20", "30"}));
+}
+
+TEST_CASE("Query attributes and predicates")
+{
+    using Catch::Matchers::Equals;
+    REQUIRE_THAT(collect(query(feed, "/feed/entry/@id"_sv)),
+                 Equals(std::vector<string_view>{"1", "2", "3"}));
+    REQUIRE_THAT(collect(query(feed, "/feed/entry[@type=\"book\"]/@id"_sv)),
+                 Equals(std::vector<string_view>{"1", "3"}));
+    REQUIRE_THAT(collect(query(feed, "/feed/entry[@type=\"cd\"]/price"_sv)),
+                 Equals(std::vector<string_view>{"20"}));
+    REQUIRE_THAT(collect(query(feed, "//entry[@id]/name"_sv)),
+                 Equals(std::vector<string_view>{"A", "B"}));
+}
+
+TEST_CASE("Query depth limit")
+{
+    auto document = "<a><a><a><a>deep</a></a></a></a>"_sv;
+    REQUIRE(collect(query<3>(document, "//a"_sv)).empty());
+    REQUIRE(query<3>(document, "//a"_sv).begin().error());
+    REQUIRE(collect(query<4>(document, "//a"_sv)) == std::vector<string_view>{"deep"});
+
+    // Skipped subtrees don't count against the limit.
+    REQUIRE(collect(query<1>(document, "/a/b"_sv)).empty());
+    REQUIRE_FALSE(query<1>(document, "/a/b"_sv).begin().error());
+}
+
+TEST_CASE("Skip subtree")
+{
+    auto document = "<ROOT><A x=\"1\"><B><!-- </A> --><?pi </A>?><C/></B>text</A><D/></ROOT>"_sv;
+
+    detail::token_state<char, std::char_traits<char>> fsm(document);
+    fsm.split(); // START_DOCUMENT
+    fsm.split(); // ROOT
+    fsm.split();
+    REQUIRE(fsm.last_token() == token{ELEMENT::START_ELEMENT, "A"_sv, ""_sv});
+    REQUIRE(fsm.has_attributes());
+    REQUIRE(fsm.depth() == 2);
+
+    REQUIRE(fsm.skip_subtree());
+    REQUIRE(fsm.last_token() == token{ELEMENT::END_ELEMENT, "A"_sv, ""_sv});
+    REQUIRE(fsm.depth() == 1);
+
+    fsm.split();
+    REQUIRE(fsm.last_token() == token{ELEMENT::START_ELEMENT, "D"_sv, ""_sv});
+    REQUIRE(fsm.skip_subtree());
+    REQUIRE(fsm.last_token() == token{ELEMENT::END_ELEMENT, "D"_sv, ""_sv});
+
+    REQUIRE(fsm.skip_subtree());
+    REQUIRE(fsm.last_token() == token{ELEMENT::END_ELEMENT, "ROOT"_sv, ""_sv});
+    REQUIRE(fsm.depth() == 0);
+
+    fsm.split();
+    REQUIRE(fsm.last_token() == token{ELEMENT::END_DOCUMENT, ""_sv, ""_sv});
+    REQUIRE(fsm.skip_subtree() == false);
+}
+
+}
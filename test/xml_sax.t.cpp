@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_sax.hpp"
+#include "svbb/util.hpp"
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+// Builds events with append(), "a" + std::string(b) trips GCC 12's -Wrestrict in optimized
+// C++20 builds.
+std::string event(std::initializer_list<string_view> parts)
+{
+    std::string result;
+    for(auto part : parts)
+        result.append(part.data(), part.size());
+    return result;
+}
+
+struct recorder
+{
+    std::vector<std::string> events;
+
+    void on_start_document() { events.push_back("start_document"); }
+    void on_end_document() { events.push_back("end_document"); }
+    void on_prolog(string_view name, string_view value)
+    {
+        events.push_back(event({"prolog ", name, " ", value}));
+    }
+    void on_start_element(string_view qname) { events.push_back(event({"<", qname})); }
+    void on_attribute(string_view qname, string_view value)
+    {
+        events.push_back(event({"@", qname, "=", value}));
+    }
+    void on_characters(string_view value) { events.push_back(event({"'", value, "'"})); }
+    void on_end_element(string_view qname) { events.push_back(event({">", qname})); }
+    void on_processing_instruction(string_view target, string_view data)
+    {
+        events.push_back(event({"pi ", target, " ", data}));
+    }
+    void on_error(string_view message) { events.push_back(event({"error ", message})); }
+};
+
+struct element_counter
+{
+    int elements = 0;
+    void on_start_element(string_view) { ++elements; }
+};
+
+const auto document = "<?xml version=\"1.0\"?>"
+    "<ROOT a=\"1\"><node b=\"2\" c=\"3\">text</node><?pi data?><EMPTY d=\"4\"/></ROOT>"_sv;
+
+TEST_CASE("SAX all callbacks")
+{
+    using Catch::Matchers::Equals;
+    recorder handler;
+    REQUIRE(parse(document, handler));
+    REQUIRE_THAT(handler.events, Equals(std::vector<std::string>{
+        "start_document", "prolog xml version=\"1.0\"", "<ROOT", "@a=1", "<node", "@b=2", "@c=3",
+        "'text'", ">node", "pi pi data", "<EMPTY", "@d=4", ">EMPTY", ">ROOT", "end_document"}));
+}
+
+TEST_CASE("SAX partial handler")
+{
+    static_assert(sax::handles_attributes<recorder, string_view>::value, "");
+    static_assert(!sax::handles_attributes<element_counter, string_view>::value, "");
+
+    element_counter handler;
+    REQUIRE(parse(document, handler));
+    REQUIRE(handler.elements == 3);
+}
+
+struct comment_collector
+{
+    std::vector<std::string> comments;
+    void on_comment(string_view value) { comments.push_back(std::string(value)); }
+};
+
+TEST_CASE("SAX comments")
+{
+    using Catch::Matchers::Equals;
+    static_assert(sax::handles_comments<comment_collector, string_view>::value, "");
+    static_assert(!sax::handles_processing_instructions<comment_collector, string_view>::value, "");
+
+    comment_collector handler;
+    REQUIRE(parse("<!-- first --><ROOT><?pi data?><!--second--></ROOT>"_sv, handler));
+    REQUIRE_THAT(handler.comments, Equals(std::vector<std::string>{" first ", "second"}));
+}
+
+TEST_CASE("SAX malformed document")
+{
+    recorder handler;
+    REQUIRE_FALSE(parse("no markup"_sv, handler));
+    REQUIRE(handler.events.back() == "error Malformed document");
+}
+
+}
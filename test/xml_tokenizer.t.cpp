@@ -4,6 +4,9 @@
 #include "svbb/util.hpp"
 #include <vector>
 #include <algorithm>
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
 
 namespace {
 using namespace SVBB_NAMESPACE;
@@ -188,4 +191,250 @@ TEST_CASE("Parse simple doc - comment out bad structure")
     REQUIRE(fsm.empty() == true);
 }
 
-}
\ No newline at end of file
+template<typename Policy = default_policy>
+std::vector<token<char, std::char_traits<char>>> all_tokens(string_view document)
+{
+    std::vector<token<char, std::char_traits<char>>> tokens;
+    for(auto t : tokenize<Policy>(document))
+        tokens.push_back(t);
+    return tokens;
+}
+
+using token_type = token<char, std::char_traits<char>>;
+
+const auto policy_document = "<?xml version=\"1.0\"?>\n"
+    "<ROOT a=\"1\">\n  <!-- note -->\n  <node b=\"2\"> text </node><?pi data?><EMPTY c=\"3\"/>\n</ROOT>"_sv;
+
+struct untrimmed : default_policy { static constexpr bool trim_text = false; };
+struct no_attributes : default_policy { static constexpr bool attributes = false; };
+struct markup : default_policy
+{
+    static constexpr bool comments = true;
+    static constexpr bool processing_instructions = false;
+};
+struct no_depth : default_policy { static constexpr bool track_depth = false; };
+
+TEST_CASE("Policy - default")
+{
+    REQUIRE(all_tokens(policy_document) == std::vector<token_type>{
+        {ELEMENT::START_DOCUMENT},
+        {ELEMENT::PROLOG, "xml"_sv, "version=\"1.0\""_sv},
+        {ELEMENT::START_ELEMENT, "ROOT"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "a"_sv, "1"_sv},
+        {ELEMENT::START_ELEMENT, "node"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "b"_sv, "2"_sv},
+        {ELEMENT::CHARACTERS, "text"_sv},
+        {ELEMENT::END_ELEMENT, "node"_sv},
+        {ELEMENT::PROCESSING_INSTRUCTION, "pi"_sv, "data"_sv},
+        {ELEMENT::START_ELEMENT, "EMPTY"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "c"_sv, "3"_sv},
+        {ELEMENT::END_ELEMENT, "EMPTY"_sv},
+        {ELEMENT::END_ELEMENT, "ROOT"_sv}});
+}
+
+TEST_CASE("Policy - untrimmed text")
+{
+    REQUIRE(all_tokens<untrimmed>("<ROOT>\n <a> text </a></ROOT>"_sv)
+            == std::vector<token_type>{
+                {ELEMENT::START_DOCUMENT},
+                {ELEMENT::START_ELEMENT, "ROOT"_sv},
+                {ELEMENT::CHARACTERS, "\n "_sv},
+                {ELEMENT::START_ELEMENT, "a"_sv},
+                {ELEMENT::CHARACTERS, " text "_sv},
+                {ELEMENT::END_ELEMENT, "a"_sv},
+                {ELEMENT::END_ELEMENT, "ROOT"_sv}});
+}
+
+TEST_CASE("Policy - no attributes")
+{
+    REQUIRE(all_tokens<no_attributes>("<ROOT a=\"1\"><EMPTY c=\"3\"/><e/></ROOT>"_sv)
+            == std::vector<token_type>{
+                {ELEMENT::START_DOCUMENT},
+                {ELEMENT::START_ELEMENT, "ROOT"_sv},
+                {ELEMENT::START_ELEMENT, "EMPTY"_sv},
+                {ELEMENT::END_ELEMENT, "EMPTY"_sv},
+                {ELEMENT::START_ELEMENT, "e"_sv},
+                {ELEMENT::END_ELEMENT, "e"_sv},
+                {ELEMENT::END_ELEMENT, "ROOT"_sv}});
+}
+
+TEST_CASE("Policy - comments reported, processing instructions skipped")
+{
+    REQUIRE(all_tokens<markup>(policy_document) == std::vector<token_type>{
+        {ELEMENT::START_DOCUMENT},
+        {ELEMENT::START_ELEMENT, "ROOT"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "a"_sv, "1"_sv},
+        {ELEMENT::COMMENT, " note "_sv},
+        {ELEMENT::START_ELEMENT, "node"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "b"_sv, "2"_sv},
+        {ELEMENT::CHARACTERS, "text"_sv},
+        {ELEMENT::END_ELEMENT, "node"_sv},
+        {ELEMENT::START_ELEMENT, "EMPTY"_sv},
+        {ELEMENT::ELEMENT_ATTRIBUTE, "c"_sv, "3"_sv},
+        {ELEMENT::END_ELEMENT, "EMPTY"_sv},
+        {ELEMENT::END_ELEMENT, "ROOT"_sv}});
+}
+
+TEST_CASE("Policy - no depth tracking")
+{
+    xml::detail::token_state<char, std::char_traits<char>, no_depth> fsm("<ROOT><a/></ROOT>\n"_sv);
+    int tokens = 0;
+    while(!fsm.empty()){
+        fsm.split();
+        REQUIRE(fsm.depth() == 0);
+        ++tokens;
+    }
+    REQUIRE(fsm.last_token() == token_type{ELEMENT::END_DOCUMENT});
+    REQUIRE(tokens == 6);
+}
+
+TEST_CASE("Unterminated comment")
+{
+    xml::detail::token_state fsm("<ROOT><!-- open"_sv);
+    while(!fsm.empty())
+        fsm.split();
+    REQUIRE(fsm.last_token().element == ELEMENT::ERROR);
+}
+
+TEST_CASE("Single quoted attributes")
+{
+    std::vector<token<char, std::char_traits<char>>> tokens;
+    for(auto t : tokenize("<ROOT a='1' b = \"'2'\"/>"_sv))
+        tokens.push_back(t);
+    REQUIRE(tokens.size() == 5);
+    REQUIRE(tokens[2] == token{ELEMENT::ELEMENT_ATTRIBUTE, "a"_sv, "1"_sv});
+    REQUIRE(tokens[3] == token{ELEMENT::ELEMENT_ATTRIBUTE, "b"_sv, "'2'"_sv});
+}
+
+TEST_CASE("Malformed attributes")
+{
+    for(auto document : {"<ROOT a>"_sv, "<ROOT a=1>"_sv, "<ROOT a=\"1>"_sv, "<ROOT a=>"_sv}){
+        xml::detail::token_state fsm(document);
+        fsm.set_log_errors(false);
+        size_t splits = 0;
+        while(!fsm.empty() && ++splits < 10)
+            fsm.split();
+        REQUIRE(fsm.last_token().element == ELEMENT::ERROR);
+    }
+}
+
+TEST_CASE("Iterator skip_subtree")
+{
+    auto document = "<ROOT><payload a=\"1\"><x>1</x><!-- </payload> --><y/><?pi ?></payload>"
+                    "<keep>text</keep></ROOT>"_sv;
+    auto it = tokenize(document).begin();
+    ++it; // ROOT
+    ++it; // payload
+    REQUIRE(*it == token_type{ELEMENT::START_ELEMENT, "payload"_sv});
+    REQUIRE(it.skip_subtree());
+    REQUIRE(*it == token_type{ELEMENT::END_ELEMENT, "payload"_sv});
+    REQUIRE(*++it == token_type{ELEMENT::START_ELEMENT, "keep"_sv});
+    REQUIRE(*++it == token_type{ELEMENT::CHARACTERS, "text"_sv});
+    REQUIRE(it.skip_subtree());
+    REQUIRE(*it == token_type{ELEMENT::END_ELEMENT, "keep"_sv});
+    REQUIRE(*++it == token_type{ELEMENT::END_ELEMENT, "ROOT"_sv});
+    REQUIRE(++it == tokenize(document).end());
+}
+
+TEST_CASE("Iterator skip_to_element")
+{
+    auto document = "<ROOT><a><price>1</price></a><b x=\"2\"/><price cur=\"EUR\">2</price>"
+                    "<prices>3</prices></ROOT>"_sv;
+    auto range = tokenize(document);
+    auto it = range.begin();
+    REQUIRE(it.skip_to_element("price"_sv));
+    REQUIRE(*it == token_type{ELEMENT::START_ELEMENT, "price"_sv});
+    REQUIRE(*++it == token_type{ELEMENT::CHARACTERS, "1"_sv});
+    REQUIRE(it.skip_to_element("price"_sv));
+    REQUIRE(*++it == token_type{ELEMENT::ELEMENT_ATTRIBUTE, "cur"_sv, "EUR"_sv});
+    REQUIRE(*++it == token_type{ELEMENT::CHARACTERS, "2"_sv});
+    REQUIRE_FALSE(it.skip_to_element("price"_sv));
+    REQUIRE(it == range.end());
+
+    auto root = range.begin();
+    REQUIRE(root.skip_to_element("ROOT"_sv));
+    REQUIRE(*root == token_type{ELEMENT::START_ELEMENT, "ROOT"_sv});
+}
+
+struct validating : default_policy { static constexpr bool validate_utf8 = true; };
+
+TEST_CASE("Policy - UTF-8 validation")
+{
+    auto valid = "<ROOT a=\"caf\xc3\xa9\">\xe2\x82\xac</ROOT>"_sv;
+    REQUIRE(all_tokens<validating>(valid) == all_tokens(valid));
+
+    xml::detail::token_state<char, std::char_traits<char>, validating> fsm(
+        "<ROOT><a>ok</a><b>bad \xc3( text</b></ROOT>"_sv);
+    std::vector<token_type> tokens;
+    while(!fsm.empty()){
+        fsm.split();
+        tokens.push_back(fsm.last_token());
+    }
+    REQUIRE(tokens.back() == token_type{ELEMENT::ERROR, "Invalid UTF-8."_sv});
+    REQUIRE(tokens[tokens.size() - 2] == token_type{ELEMENT::START_ELEMENT, "b"_sv});
+    REQUIRE(fsm.utf8_error_offset() == 22);
+
+    xml::detail::token_state<char, std::char_traits<char>, validating> skipping(
+        "<ROOT><a>\xff</a></ROOT>"_sv);
+    skipping.split();
+    skipping.split();
+    REQUIRE_FALSE(skipping.skip_to_element("b"_sv));
+    REQUIRE(skipping.last_token().element == ELEMENT::ERROR);
+    REQUIRE(skipping.utf8_error_offset() == 9);
+}
+
+TEST_CASE("Policy - UTF-8 validation after the root element")
+{
+    auto last_token = [](string_view document) {
+        xml::detail::token_state<char, std::char_traits<char>, validating> fsm(document);
+        fsm.set_log_errors(false);
+        while(!fsm.empty())
+            fsm.split();
+        return std::make_pair(fsm.last_token(), fsm.utf8_error_offset());
+    };
+
+    REQUIRE(last_token("<a/>\n\xc3\xa9 "_sv).first.element == ELEMENT::END_DOCUMENT);
+
+    const auto invalid = last_token("<a/>\xff"_sv);
+    REQUIRE(invalid.first == token_type{ELEMENT::ERROR, "Invalid UTF-8."_sv});
+    REQUIRE(invalid.second == 4);
+
+    const auto truncated = last_token("<a>x</a> \xe2\x82"_sv);
+    REQUIRE(truncated.first == token_type{ELEMENT::ERROR, "Invalid UTF-8."_sv});
+    REQUIRE(truncated.second == 9);
+
+    xml::detail::token_state<char, std::char_traits<char>, validating> skipping(
+        "<ROOT><a/></ROOT>\xe2"_sv);
+    skipping.set_log_errors(false);
+    skipping.split();
+    REQUIRE_FALSE(skipping.skip_to_element("b"_sv));
+    REQUIRE(skipping.last_token().element == ELEMENT::ERROR);
+    REQUIRE(skipping.utf8_error_offset() == 17);
+}
+
+TEST_CASE("Iterator valid")
+{
+    auto rng = tokenize("<a/>"_sv);
+    REQUIRE(rng.begin().valid());
+    REQUIRE_FALSE(rng.end().valid());
+}
+
+#if defined(__cpp_lib_ranges)
+static_assert(std::ranges::forward_range<xml::token_range<char, std::char_traits<char>>>);
+static_assert(std::ranges::view<xml::token_range<char, std::char_traits<char>>>);
+static_assert(std::ranges::borrowed_range<xml::token_range<char, std::char_traits<char>>>);
+
+TEST_CASE("Tokenize with std::ranges")
+{
+    auto is_element = [](const token<char, std::char_traits<char>>& t){
+        return t.element == ELEMENT::START_ELEMENT;
+    };
+    auto names = tokenize("<a><b x=\"1\"/><c/></a>"_sv) | std::views::filter(is_element) |
+                 std::views::transform([](const auto& t){ return t.qname; }) |
+                 std::views::drop(1);
+    std::vector<string_view> result(names.begin(), names.end());
+    REQUIRE(result == std::vector<string_view>{"b"_sv, "c"_sv});
+}
+#endif
+
+}
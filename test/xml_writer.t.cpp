@@ -0,0 +1,128 @@
+#include "catch.hpp"
+#include "test_config.hpp"
+#include "svbb/xml_writer.hpp"
+#include "svbb/util.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+using namespace SVBB_NAMESPACE;
+using namespace SVBB_NAMESPACE::literals;
+using namespace SVBB_NAMESPACE::xml;
+
+// Same members as struct iovec from <sys/uio.h>.
+struct test_iovec
+{
+    void* iov_base;
+    size_t iov_len;
+};
+
+TEST_CASE("Writer builds elements")
+{
+    writer<char> out;
+    out.start_element("ROOT"_sv);
+    out.attribute("a"_sv, "1"_sv);
+    out.start_element("node"_sv);
+    out.characters("text"_sv);
+    out.end_element("node"_sv);
+    out.start_element("EMPTY"_sv);
+    out.end_element("EMPTY"_sv);
+    out.comment(" note "_sv);
+    out.processing_instruction("pi"_sv, "data"_sv);
+    out.end_element("ROOT"_sv);
+
+    const auto expected = "<ROOT a=\"1\"><node>text</node><EMPTY/><!-- note --><?pi data?></ROOT>"_sv;
+    REQUIRE(out.str() == expected);
+    REQUIRE(out.size() == expected.size());
+}
+
+TEST_CASE("Writer escapes only when needed")
+{
+    writer<char> out;
+    const auto clean = "nothing special in this rather long piece of text"_sv;
+    out.start_element("a"_sv);
+    out.attribute("q"_sv, "say \"<&>\""_sv);
+    out.characters(clean);
+    out.characters(" 1 < 2 & 3 > 2 \"quoted\""_sv);
+    out.end_element("a"_sv);
+
+    REQUIRE(out.str() == "<a q=\"say &quot;&lt;&amp;&gt;&quot;\">nothing special in this rather "
+                         "long piece of text 1 &lt; 2 &amp; 3 &gt; 2 \"quoted\"</a>");
+    bool clean_is_view = false;
+    for(size_t i = 0; i < out.segment_count(); ++i)
+        clean_is_view |= out.segment(i).data() == clean.data();
+    REQUIRE(clean_is_view);
+}
+
+TEST_CASE("Writer round trips tokens without copying them")
+{
+    const auto document = "<?xml version=\"1.0\"?><ROOT a=\"x &amp; y\"><node>1 &lt; 2</node>"
+                          "<EMPTY b=\"2\"/></ROOT>"_sv;
+    writer<char> out;
+    for(auto t : tokenize(document))
+        out.write(t);
+    REQUIRE(out.str() == document);
+
+    size_t copied = 0;
+    for(size_t i = 0; i < out.segment_count(); ++i){
+        const auto s = out.segment(i);
+        if(s.data() < document.data() || s.data() >= document.data() + document.size())
+            copied += s.size();
+    }
+    REQUIRE(copied < document.size() / 2);
+}
+
+TEST_CASE("Writer keeps attribute values quoted")
+{
+    const auto document = "<a b='say \"hi\"' c=\"it's\" d='x &apos; y'/>"_sv;
+    writer<char> out;
+    for(auto t : tokenize(document))
+        out.write(t);
+    const auto written = out.str();
+    REQUIRE(written == "<a b='say \"hi\"' c=\"it's\" d=\"x &apos; y\"/>");
+
+    std::vector<std::string> values;
+    for(auto t : tokenize(string_view(written))){
+        REQUIRE(t.element != ELEMENT::ERROR);
+        if(t.element == ELEMENT::ELEMENT_ATTRIBUTE)
+            values.push_back(std::string(t.value.data(), t.value.size()));
+    }
+    REQUIRE(values == std::vector<std::string>{"say \"hi\"", "it's", "x &apos; y"});
+
+    writer<char> both;
+    both.start_element("a"_sv);
+    both.write(writer<char>::token_type{ELEMENT::ELEMENT_ATTRIBUTE, "b"_sv, "'\"'"_sv});
+    both.end_element("a"_sv);
+    REQUIRE(both.str() == "<a b=\"'&quot;'\"/>");
+}
+
+TEST_CASE("Writer fills iovecs")
+{
+    const auto text = "some text"_sv;
+    writer<char> out;
+    out.start_element("ROOT"_sv);
+    out.characters(text);
+    out.end_element("ROOT"_sv);
+
+    std::vector<test_iovec> iov(2);
+    std::string gathered;
+    size_t first = 0;
+    while(size_t n = out.fill_iovec(iov.data(), iov.size(), first)){
+        for(size_t i = 0; i < n; ++i)
+            gathered.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        first += n;
+    }
+    REQUIRE(first == out.segment_count());
+    REQUIRE(gathered == out.str());
+
+    std::vector<char> buffer;
+    out.append_to(buffer);
+    REQUIRE(std::string(buffer.begin(), buffer.end()) == "<ROOT>some text</ROOT>");
+
+    out.clear();
+    REQUIRE(out.size() == 0);
+    out.raw("<x/>"_sv);
+    REQUIRE(out.str() == "<x/>");
+}
+
+}